@@ -0,0 +1,221 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+/** @file
+ *  @brief Micro benchmark for the regular expression engine of doxygen.
+ *
+ *  Collects the raw string patterns passed to reg::Ex in the doxygen sources,
+ *  also when the declaration spans multiple lines or selects the wildcard mode,
+ *  and the date formats of datetime.cpp, which are compiled to reg::Ex as well.
+ *  Each pattern is searched in all lines of the given corpus files, the same
+ *  way reg::Iterator is used throughout doxygen. For each pattern the number of
+ *  matches, a checksum of the positions and lengths of the matches and their
+ *  sub matches, and the time taken are reported, so changes to the engine can
+ *  be compared against a previous build for both speed and results.
+ *
+ *  Usage: doxyregexbench [-n repeat] srcdir corpus_file...
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "regex.h"
+#include "dir.h"
+
+static bool endsWith(const std::string &s,const char *suffix)
+{
+  size_t n = strlen(suffix);
+  return s.length()>=n && s.compare(s.length()-n,n,suffix)==0;
+}
+
+static bool readLines(const std::string &fileName,std::vector<std::string> &lines)
+{
+  std::ifstream f(fileName,std::ios::binary);
+  if (!f.is_open()) return false;
+  std::string line;
+  while (std::getline(f,line)) lines.push_back(line);
+  return true;
+}
+
+static bool readFile(const std::string &fileName,std::string &contents)
+{
+  std::ifstream f(fileName,std::ios::binary);
+  if (!f.is_open()) return false;
+  contents.assign(std::istreambuf_iterator<char>(f),std::istreambuf_iterator<char>());
+  return true;
+}
+
+struct Pattern
+{
+  std::string   text;
+  reg::Ex::Mode mode;
+  bool operator<(const Pattern &other) const
+  {
+    return text!=other.text ? text<other.text : mode<other.mode;
+  }
+};
+
+// Reads the raw string literal starting at position i of s, which may use a delimiter,
+// as in R"x(...)x". Returns the position after the literal, or std::string::npos.
+static size_t readRawString(const std::string &s,size_t i,std::string &literal)
+{
+  if (s.compare(i,2,"R\"")!=0) return std::string::npos;
+  size_t open = s.find('(',i+2);
+  if (open==std::string::npos) return std::string::npos;
+  std::string terminator = ")"+s.substr(i+2,open-i-2)+"\"";
+  size_t close = s.find(terminator,open+1);
+  if (close==std::string::npos) return std::string::npos;
+  literal = s.substr(open+1,close-open-1);
+  return close+terminator.length();
+}
+
+// finds the raw string patterns passed to reg::Ex in the doxygen sources,
+// and returns the number of places they are used in via \a uses
+static std::set<Pattern> collectPatterns(const std::string &srcDir,size_t &uses)
+{
+  // the raw string following one of these is compiled to a reg::Ex
+  static const char *markers[] = { "reg::Ex", "SpecFormat{" };
+  std::set<Pattern> patterns;
+  std::vector<std::string> files;
+  Dir dir(srcDir);
+  for (const auto &entry : dir.iterator())
+  {
+    std::string name = entry.path();
+    if (entry.is_regular_file() && (endsWith(name,".cpp") || endsWith(name,".h") || endsWith(name,".l")))
+    {
+      files.push_back(name);
+    }
+  }
+  uses = 0;
+  for (const auto &file : files)
+  {
+    std::string s;
+    readFile(file,s);
+    for (const char *marker : markers)
+    {
+      size_t len = strlen(marker);
+      for (size_t i = s.find(marker); i!=std::string::npos; i = s.find(marker,i+len))
+      {
+        // skip the variable name, brackets, and a std::string_view( wrapper, possibly across lines
+        size_t j = i+len;
+        while (j<s.length() && s.compare(j,2,"R\"")!=0 &&
+               (isalnum(static_cast<unsigned char>(s[j])) || isspace(static_cast<unsigned char>(s[j])) ||
+                s[j]=='_' || s[j]==':' || s[j]=='(' || s[j]=='{'))
+        {
+          j++;
+        }
+        std::string literal;
+        size_t end = j<s.length() ? readRawString(s,j,literal) : std::string::npos;
+        if (end==std::string::npos) continue;
+        size_t close = s.find_first_of(";)}",end);
+        bool wildcard = s.substr(end,close-end).find("Wildcard")!=std::string::npos;
+        patterns.insert(Pattern{ literal, wildcard ? reg::Ex::Mode::Wildcard : reg::Ex::Mode::RegEx });
+        uses++;
+      }
+    }
+  }
+  return patterns;
+}
+
+int main(int argc,char **argv)
+{
+  int repeat = 1;
+  int argi = 1;
+  if (argi+1<argc && strcmp(argv[argi],"-n")==0)
+  {
+    repeat = std::max(1,atoi(argv[argi+1]));
+    argi+=2;
+  }
+  if (argc-argi<2)
+  {
+    fprintf(stderr,"Usage: %s [-n repeat] srcdir corpus_file...\n",argv[0]);
+    return 1;
+  }
+  size_t uses = 0;
+  std::set<Pattern> patterns = collectPatterns(argv[argi++],uses);
+  if (patterns.empty())
+  {
+    fprintf(stderr,"No patterns found\n");
+    return 1;
+  }
+  std::vector<std::string> corpus;
+  for (; argi<argc; argi++)
+  {
+    if (!readLines(argv[argi],corpus))
+    {
+      fprintf(stderr,"Cannot read %s\n",argv[argi]);
+      return 1;
+    }
+  }
+
+  using clock = std::chrono::steady_clock;
+  double total = 0;
+  printf("%10s %16s %10s  %s\n","matches","checksum","time(ms)","pattern");
+  for (const auto &pattern : patterns)
+  {
+    reg::Ex re(pattern.text,pattern.mode);
+    size_t matches = 0;
+    uint64_t checksum = 14695981039346656037ULL; // FNV-1a over line, position and length of each (sub)match
+    auto add = [&checksum](size_t v)
+    {
+      for (int b=0; b<8; b++)
+      {
+        checksum = (checksum ^ ((v>>(b*8))&0xff)) * 1099511628211ULL;
+      }
+    };
+    auto start = clock::now();
+    for (int r=0; r<repeat; r++)
+    {
+      for (size_t l=0; l<corpus.size(); l++)
+      {
+        reg::Iterator it(corpus[l],re);
+        reg::Iterator end;
+        for (; it!=end; ++it)
+        {
+          matches++;
+          if (r==0)
+          {
+            const reg::Match &m = *it;
+            add(l);
+            for (size_t i=0; i<m.size(); i++)
+            {
+              add(m[i].position());
+              add(m[i].length());
+            }
+          }
+        }
+      }
+    }
+    double ms = std::chrono::duration<double,std::milli>(clock::now()-start).count();
+    total+=ms;
+    printf("%10zu %016llx %10.2f  %s%s\n",matches/static_cast<size_t>(repeat),
+           static_cast<unsigned long long>(checksum),ms,pattern.text.c_str(),
+           pattern.mode==reg::Ex::Mode::Wildcard ? "  (wildcard)" : "");
+  }
+  printf("%10s %16s %10.2f  total for %zu patterns (used %zu times) on %zu lines\n","","",total,
+         patterns.size(),uses,corpus.size());
+  return 0;
+}
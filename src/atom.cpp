@@ -0,0 +1,143 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "atom.h"
+
+namespace
+{
+
+/** Global string table, divided into shards so threads interning different
+ *  strings do not have to wait for each other.
+ *
+ *  Each shard indexes its entries with an open addressing hash table of atomic
+ *  pointers. Entries are never removed, so a lookup only has to load the
+ *  pointers with acquire semantics and needs no lock. Adding an entry takes the
+ *  shard's mutex. When the table gets too full it is replaced by a larger copy,
+ *  the old table is kept alive since other threads may still be reading it.
+ */
+class StringTable
+{
+  public:
+    static StringTable &instance()
+    {
+      static StringTable table;
+      return table;
+    }
+
+    const AtomEntry *find(std::string_view s,size_t hash) const
+    {
+      const Shard &shard = m_shards[hash%g_numShards];
+      return shard.table.load(std::memory_order_acquire)->find(s,hash);
+    }
+
+    const AtomEntry *intern(std::string_view s)
+    {
+      size_t hash = std::hash<std::string_view>()(s);
+      const AtomEntry *entry = find(s,hash);
+      if (entry) return entry;
+      Shard &shard = m_shards[hash%g_numShards];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      Table *table = shard.table.load(std::memory_order_relaxed);
+      entry = table->find(s,hash);
+      if (entry) return entry; // added by another thread in the meantime
+      if ((shard.entries.size()+1)*2>table->slots.size()) // keep the load factor below 1/2
+      {
+        auto newTable = std::make_unique<Table>(table->slots.size()*2);
+        for (const auto &e : shard.entries) newTable->add(&e);
+        table = newTable.get();
+        shard.tables.push_back(std::move(newTable));
+        shard.table.store(table,std::memory_order_release);
+      }
+      // entries are only appended, so the strings the table refers to never move
+      const AtomEntry &e = shard.entries.emplace_back(s,m_nextId.fetch_add(1,std::memory_order_relaxed),hash);
+      table->add(&e);
+      return &e;
+    }
+
+    size_t count() const
+    {
+      return m_nextId.load(std::memory_order_relaxed)-1;
+    }
+
+  private:
+    static constexpr size_t g_numShards    = 64;
+    static constexpr size_t g_initialSlots = 256;
+
+    struct Table
+    {
+      explicit Table(size_t numSlots) : slots(numSlots) {}
+      std::vector< std::atomic<const AtomEntry*> > slots; // size is a power of two
+
+      const AtomEntry *find(std::string_view s,size_t hash) const
+      {
+        size_t mask = slots.size()-1;
+        // the low bits of the hash select the shard, so use the others for the slot
+        for (size_t i=(hash/g_numShards)&mask;;i=(i+1)&mask)
+        {
+          const AtomEntry *e = slots[i].load(std::memory_order_acquire);
+          if (e==nullptr) return nullptr;
+          if (e->hash==hash && e->str==s) return e;
+        }
+      }
+
+      void add(const AtomEntry *e) // called with the shard's mutex locked
+      {
+        size_t mask = slots.size()-1;
+        size_t i=(e->hash/g_numShards)&mask;
+        while (slots[i].load(std::memory_order_relaxed)!=nullptr) i=(i+1)&mask;
+        slots[i].store(e,std::memory_order_release);
+      }
+    };
+
+    struct Shard
+    {
+      Shard() { tables.push_back(std::make_unique<Table>(g_initialSlots)); table=tables.back().get(); }
+      std::mutex mutex;
+      std::deque<AtomEntry> entries;
+      std::atomic<Table*> table;
+      std::vector< std::unique_ptr<Table> > tables; // all tables ever used by this shard
+    };
+    std::array<Shard,g_numShards> m_shards;
+    std::atomic<uint32_t> m_nextId = 1; // 0 is used for invalid atoms
+};
+
+} // namespace
+
+Atom::Atom(std::string_view s) : m_entry(StringTable::instance().intern(s))
+{
+}
+
+Atom Atom::find(std::string_view s)
+{
+  return Atom(StringTable::instance().find(s,std::hash<std::string_view>()(s)));
+}
+
+size_t Atom::count()
+{
+  return StringTable::instance().count();
+}
+
+const std::string &Atom::emptyString()
+{
+  static const std::string empty;
+  return empty;
+}
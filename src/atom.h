@@ -0,0 +1,93 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef ATOM_H
+#define ATOM_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "qcstring.h"
+
+/** @brief Entry in the string table used by Atom. */
+struct AtomEntry
+{
+  AtomEntry(std::string_view s,uint32_t i,size_t h) : str(s), id(i), hash(h) {}
+  const std::string str;
+  const uint32_t id;
+  const size_t hash; //!< hash of \a str, so a lookup compares strings only when the hashes match
+};
+
+/** @brief Handle to a string stored once in a global string table.
+ *
+ *  Equal strings are interned to the same entry, so comparing two atoms is
+ *  a pointer comparison and hashing an atom uses its small integer id,
+ *  independent of the length of the string. Interned strings live until the
+ *  end of the program, so atoms are meant for names such as identifiers and
+ *  qualified names that are used as keys in the symbol tables.
+ *
+ *  Interning and looking up strings is thread-safe. Looking up a string does
+ *  not take a lock, so threads resolving symbols do not contend on the table.
+ */
+class Atom
+{
+  public:
+    /** Creates an invalid atom that does not correspond to any string. */
+    Atom() = default;
+
+    /** Returns the atom for string \a s, adding \a s to the string table if needed. */
+    explicit Atom(std::string_view s);
+    explicit Atom(const std::string &s) : Atom(std::string_view(s)) {}
+    explicit Atom(const QCString &s) : Atom(s.view()) {}
+    explicit Atom(const char *s) : Atom(std::string_view(s ? s : "")) {}
+
+    /** Returns the atom for string \a s if it was interned before, or an invalid atom otherwise.
+     *  Unlike the constructor this never adds a string, which is useful when a name
+     *  is only looked up, since a name that was never interned cannot be a key in any map.
+     */
+    static Atom find(std::string_view s);
+    static Atom find(const std::string &s) { return find(std::string_view(s)); }
+    static Atom find(const QCString &s)    { return find(s.view()); }
+    static Atom find(const char *s)        { return find(std::string_view(s ? s : "")); }
+
+    /** Returns the number of strings in the string table. */
+    static size_t count();
+
+    bool isValid() const { return m_entry!=nullptr; }
+
+    /** Returns a number that uniquely identifies the string, or 0 for an invalid atom. */
+    uint32_t id() const { return m_entry ? m_entry->id : 0; }
+
+    /** Returns the string, or an empty string for an invalid atom. */
+    const std::string &str() const { return m_entry ? m_entry->str : emptyString(); }
+    QCString qstr() const { return QCString(str()); }
+
+    bool operator==(const Atom &other) const { return m_entry==other.m_entry; }
+    bool operator!=(const Atom &other) const { return m_entry!=other.m_entry; }
+
+  private:
+    explicit Atom(const AtomEntry *entry) : m_entry(entry) {}
+    static const std::string &emptyString();
+    const AtomEntry *m_entry = nullptr;
+};
+
+template<> struct std::hash<Atom>
+{
+  size_t operator()(const Atom &atom) const { return atom.id(); }
+};
+
+#endif
@@ -16,9 +16,18 @@
 #ifndef CACHE_H
 #define CACHE_H
 
+#include <algorithm>
 #include <list>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <functional>
 #include <unordered_map>
 #include <mutex>
+#include <atomic>
 #include <utility>
 #include <ctype.h>
 
@@ -180,4 +189,395 @@ class Cache
     uint64_t m_misses=0;
 };
 
+/*! Cache for value type V using string keys, that can be used by multiple threads.
+ *
+ *  The cache is divided into a number of shards, each with its own lock, so threads looking up
+ *  different keys rarely wait for each other. When a shard is full, an entry that was not used
+ *  since the clock hand last passed it is removed (CLOCK strategy, an approximation of LRU that
+ *  only needs to set a flag on a hit). Lookups take a std::string_view, so no string needs to be
+ *  allocated to search for a key, and return a copy of the value, so the result remains valid
+ *  when another thread evicts the entry.
+ *
+ *  The capacity is fixed unless setMemoryLimit() is used, in which case the cache periodically
+ *  adapts its capacity to the observed miss rate, without using more than the given amount of
+ *  memory.
+ */
+template<typename V>
+class ConcurrentCache
+{
+  public:
+    //! creates a cache that can hold about \a capacity elements divided over \a numShards shards
+    ConcurrentCache(size_t capacity,size_t numShards=32)
+      : m_capacity(capacity), m_initialCapacity(capacity), m_shardCapacity(shardCapacityFor(capacity,numShards))
+    {
+      for (size_t i=0;i<numShards;i++)
+      {
+        m_shards.push_back(std::make_unique<Shard>());
+      }
+    }
+
+    //! Inserts \a value under \a key in the cache, replacing any existing value.
+    void insert(std::string_view key,V value)
+    {
+      Shard &shard = shardFor(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto it = shard.index.find(key);
+      if (it!=shard.index.end())
+      {
+        Slot &slot = shard.slots[it->second];
+        slot.value = std::move(value);
+        slot.referenced = true;
+        return;
+      }
+      shard.add(key,std::move(value),m_shardCapacity.load(std::memory_order_relaxed));
+    }
+
+    //! Inserts \a value under \a key in the cache, unless a value for \a key is already present.
+    //! @returns TRUE if the value was inserted.
+    bool insertIfAbsent(std::string_view key,V value)
+    {
+      Shard &shard = shardFor(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      if (shard.index.find(key)!=shard.index.end()) return false;
+      shard.add(key,std::move(value),m_shardCapacity.load(std::memory_order_relaxed));
+      return true;
+    }
+
+    //! Finds a value in the cache given the corresponding \a key.
+    //! @returns a copy of the value or an empty optional if the key is not found in the cache
+    //! @note The hit and miss counters are updated, see hits() and misses().
+    std::optional<V> find(std::string_view key)
+    {
+      if (m_memoryLimit>0 && (m_lookups.fetch_add(1,std::memory_order_relaxed)+1)%g_adaptInterval==0)
+      {
+        adapt();
+      }
+      Shard &shard = shardFor(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto it = shard.index.find(key);
+      if (it!=shard.index.end())
+      {
+        Slot &slot = shard.slots[it->second];
+        slot.referenced = true;
+        shard.hits++;
+        return slot.value;
+      }
+      shard.misses++;
+      return std::nullopt;
+    }
+
+    //! Removes entry \a key from the cache.
+    void remove(std::string_view key)
+    {
+      Shard &shard = shardFor(key);
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto it = shard.index.find(key);
+      if (it!=shard.index.end())
+      {
+        size_t i = it->second;
+        shard.index.erase(it);
+        shard.freeSlot(i);
+      }
+    }
+
+    //! Removes all entries whose value satisfies \a predicate.
+    void removeIf(const std::function<bool(const V &)> &predicate)
+    {
+      for (auto &shard : m_shards)
+      {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (size_t i=0;i<shard->slots.size();i++)
+        {
+          Slot &slot = shard->slots[i];
+          if (slot.used && predicate(slot.value))
+          {
+            shard->index.erase(std::string_view(slot.key));
+            shard->freeSlot(i);
+          }
+        }
+      }
+    }
+
+    //! Calls \a func for each key and value stored in the cache.
+    void forEach(const std::function<void(const std::string &,const V &)> &func) const
+    {
+      for (const auto &shard : m_shards)
+      {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (const auto &slot : shard->slots)
+        {
+          if (slot.used) func(slot.key,slot.value);
+        }
+      }
+    }
+
+    //! Returns the number of values stored in the cache.
+    size_t size() const
+    {
+      return sum([](const Shard &shard) { return shard.index.size(); });
+    }
+
+    //! Returns the maximum number of values that can be stored in the cache.
+    size_t capacity() const
+    {
+      return m_capacity.load(std::memory_order_relaxed);
+    }
+
+    //! Returns how many of the find() calls did find a value in the cache.
+    uint64_t hits() const
+    {
+      return sum([](const Shard &shard) { return shard.hits; });
+    }
+
+    //! Returns how many of the find() calls did not found a value in the cache.
+    uint64_t misses() const
+    {
+      return sum([](const Shard &shard) { return shard.misses; });
+    }
+
+    //! Returns how many values were removed from the cache to make room for new ones.
+    uint64_t evictions() const
+    {
+      return sum([](const Shard &shard) { return shard.evictions; });
+    }
+
+    //! Returns an estimate of the number of bytes used by the cache.
+    size_t memoryUsage() const
+    {
+      return sum([](const Shard &shard) { return shard.memoryUsage(); });
+    }
+
+    //! Clears all values in the cache.
+    void clear()
+    {
+      for (auto &shard : m_shards)
+      {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->index.clear();
+        shard->slots.clear();
+        shard->freeList.clear();
+        shard->hand=0;
+        shard->keyBytes=0;
+      }
+    }
+
+    //! Changes the capacity of the cache, removing values if the cache holds more than \a capacity values.
+    void setCapacity(size_t capacity)
+    {
+      size_t shardCapacity = shardCapacityFor(capacity,m_shards.size());
+      m_capacity.store(capacity,std::memory_order_relaxed);
+      m_shardCapacity.store(shardCapacity,std::memory_order_relaxed);
+      for (auto &shard : m_shards)
+      {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        if (shard->slots.size()>shardCapacity)
+        {
+          shard->shrink(shardCapacity);
+        }
+      }
+    }
+
+    //! Lets the cache adapt its capacity to the miss rate, using at most about \a maxBytes of memory.
+    //! The capacity passed to the constructor is used as the minimum. A value of 0 fixes the capacity.
+    void setMemoryLimit(size_t maxBytes)
+    {
+      m_memoryLimit = maxBytes;
+    }
+
+    //! Adjusts the capacity based on the lookups since the previous call.
+    //! Called automatically from find() when a memory limit is set.
+    void adapt()
+    {
+      std::unique_lock<std::mutex> lock(m_adaptMutex,std::try_to_lock);
+      if (!lock.owns_lock() || m_memoryLimit==0) return; // another thread is already adapting
+
+      uint64_t hitCount = hits(), missCount = misses(), evictCount = evictions();
+      uint64_t windowHits      = hitCount-m_lastHits;
+      uint64_t windowMisses    = missCount-m_lastMisses;
+      uint64_t windowEvictions = evictCount-m_lastEvictions;
+      m_lastHits = hitCount; m_lastMisses = missCount; m_lastEvictions = evictCount;
+      if (windowHits+windowMisses==0) return;
+      double missRate = static_cast<double>(windowMisses)/static_cast<double>(windowHits+windowMisses);
+
+      size_t entries = size();
+      size_t bytes = memoryUsage();
+      size_t bytesPerEntry = entries>0 ? std::max<size_t>(1,bytes/entries) : sizeof(Slot)+g_indexOverhead;
+      size_t maxCapacity = std::max(m_initialCapacity,m_memoryLimit/bytesPerEntry);
+      size_t cap = capacity();
+      size_t newCap = cap;
+      if (bytes>m_memoryLimit) // over budget, e.g. because entries turned out to be larger than estimated
+      {
+        newCap = maxCapacity;
+      }
+      else if (windowEvictions>0 && missRate>g_growMissRate && cap<maxCapacity) // thrashing, more space will help
+      {
+        newCap = std::min(cap*2,maxCapacity);
+      }
+      else if (windowEvictions==0 && entries<cap/4 && cap>m_initialCapacity) // mostly empty, e.g. after a flush
+      {
+        newCap = std::max(m_initialCapacity,cap/2);
+      }
+      if (newCap!=cap)
+      {
+        setCapacity(newCap);
+      }
+    }
+
+  private:
+    // number of lookups between two calls to adapt()
+    static constexpr uint64_t g_adaptInterval = 65536;
+    // miss rate above which the cache grows if values are being evicted
+    static constexpr double   g_growMissRate  = 0.1;
+    // estimated memory used by the index for each entry
+    static constexpr size_t   g_indexOverhead = 64;
+
+    struct Slot
+    {
+      std::string key;
+      V value{};
+      bool used = false;
+      bool referenced = false;
+    };
+
+    struct Shard
+    {
+      mutable std::mutex mutex;
+      // slots are only appended, so the keys the index refers to never move
+      std::deque<Slot> slots;
+      std::unordered_map<std::string_view,size_t> index;
+      std::vector<size_t> freeList;
+      size_t hand = 0;
+      size_t keyBytes = 0;
+      uint64_t hits = 0;
+      uint64_t misses = 0;
+      uint64_t evictions = 0;
+
+      size_t memoryUsage() const
+      {
+        return slots.size()*sizeof(Slot)+keyBytes+index.size()*g_indexOverhead;
+      }
+
+      size_t allocSlot(size_t shardCapacity)
+      {
+        if (!freeList.empty())
+        {
+          size_t i = freeList.back();
+          freeList.pop_back();
+          return i;
+        }
+        if (slots.size()<shardCapacity)
+        {
+          slots.emplace_back();
+          return slots.size()-1;
+        }
+        size_t i = clockVictim();
+        Slot &slot = slots[i];
+        index.erase(std::string_view(slot.key));
+        keyBytes -= slot.key.capacity();
+        evictions++;
+        return i;
+      }
+
+      // store a new entry, the key must not be present yet
+      void add(std::string_view key,V &&value,size_t shardCapacity)
+      {
+        size_t i = allocSlot(shardCapacity);
+        Slot &slot = slots[i];
+        slot.key.assign(key.data(),key.size());
+        slot.value = std::move(value);
+        slot.used = true;
+        slot.referenced = false;
+        keyBytes += slot.key.capacity();
+        index.emplace(std::string_view(slot.key),i);
+      }
+
+      // advance the clock hand to an entry that was not used recently
+      size_t clockVictim()
+      {
+        for (;;)
+        {
+          if (hand>=slots.size()) hand=0;
+          Slot &slot = slots[hand];
+          if (slot.used && !slot.referenced)
+          {
+            return hand++;
+          }
+          slot.referenced = false;
+          hand++;
+        }
+      }
+
+      void freeSlot(size_t i)
+      {
+        Slot &slot = slots[i];
+        keyBytes -= slot.key.capacity();
+        slot.used = false;
+        slot.referenced = false;
+        slot.key = std::string();
+        slot.value = V{};
+        freeList.push_back(i);
+      }
+
+      // evicts values until at most shardCapacity remain and releases the unused slots
+      void shrink(size_t shardCapacity)
+      {
+        while (index.size()>shardCapacity)
+        {
+          size_t i = clockVictim();
+          index.erase(std::string_view(slots[i].key));
+          freeSlot(i);
+          evictions++;
+        }
+        std::deque<Slot> live;
+        for (auto &slot : slots)
+        {
+          if (slot.used) live.push_back(std::move(slot));
+        }
+        slots = std::move(live);
+        index.clear();
+        for (size_t i=0;i<slots.size();i++)
+        {
+          index.emplace(std::string_view(slots[i].key),i);
+        }
+        freeList.clear();
+        hand = 0;
+      }
+    };
+
+    static size_t shardCapacityFor(size_t capacity,size_t numShards)
+    {
+      return std::max<size_t>(1,(capacity+numShards-1)/numShards);
+    }
+
+    Shard &shardFor(std::string_view key)
+    {
+      return *m_shards[std::hash<std::string_view>()(key)%m_shards.size()];
+    }
+
+    template<class Func>
+    auto sum(Func func) const
+    {
+      decltype(func(*m_shards.front())) total = 0;
+      for (const auto &shard : m_shards)
+      {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total+=func(*shard);
+      }
+      return total;
+    }
+
+    std::atomic<size_t> m_capacity;
+    const size_t m_initialCapacity;
+    std::atomic<size_t> m_shardCapacity;
+    std::vector< std::unique_ptr<Shard> > m_shards;
+
+    // state for adapting the capacity
+    size_t m_memoryLimit = 0;
+    std::atomic<uint64_t> m_lookups = 0;
+    std::mutex m_adaptMutex;
+    uint64_t m_lastHits = 0;
+    uint64_t m_lastMisses = 0;
+    uint64_t m_lastEvictions = 0;
+};
+
 #endif
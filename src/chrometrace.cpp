@@ -0,0 +1,220 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "chrometrace.h"
+#include "portable.h"
+#include "message.h"
+
+// interval between two samples of the memory usage
+static const std::chrono::milliseconds g_sampleInterval(50);
+
+static std::atomic<int> g_nextThreadId = 1;
+
+//! returns a small number identifying the calling thread in the trace
+static int traceThreadId()
+{
+  static thread_local int id = g_nextThreadId++;
+  return id;
+}
+
+static void writeJsonString(std::ostream &t,const QCString &s)
+{
+  t << "\"";
+  for (char c : s.str())
+  {
+    switch (c)
+    {
+      case '"':  t << "\\\""; break;
+      case '\\': t << "\\\\"; break;
+      case '\n': t << "\\n";  break;
+      case '\t': t << "\\t";  break;
+      case '\r': t << "\\r";  break;
+      default:
+        if (static_cast<unsigned char>(c)<0x20)
+        {
+          t << QCString().sprintf("\\u%04x",c).data();
+        }
+        else
+        {
+          t << c;
+        }
+        break;
+    }
+  }
+  t << "\"";
+}
+
+struct TraceEvent
+{
+  enum class Kind { Span, Counter, ThreadName };
+  Kind kind;
+  const char *category;
+  QCString name;
+  int tid;
+  int64_t ts;     // start time in microseconds since the start of tracing
+  int64_t dur;    // duration in microseconds (spans only)
+  double value;   // value (counters only)
+};
+
+struct ChromeTrace::Private
+{
+  QCString fileName;
+  Clock::time_point startTime;
+  std::mutex mutex;
+  std::vector<TraceEvent> events;
+
+  // memory sampler
+  std::thread sampler;
+  std::mutex samplerMutex;
+  std::condition_variable samplerCond;
+  bool stopSampler = false;
+
+  int64_t toMicroSeconds(Clock::time_point tp) const
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(tp-startTime).count();
+  }
+  void addEvent(TraceEvent &&e)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.push_back(std::move(e));
+  }
+  void sampleMemory()
+  {
+    std::unique_lock<std::mutex> lock(samplerMutex);
+    do
+    {
+      double rss = static_cast<double>(Portable::residentMemorySize())/(1024.0*1024.0);
+      addEvent({TraceEvent::Kind::Counter,"memory","RSS (MB)",0,toMicroSeconds(Clock::now()),0,rss});
+    }
+    while (!samplerCond.wait_for(lock,g_sampleInterval,[this]() { return stopSampler; }));
+  }
+  void write()
+  {
+    std::ofstream f = Portable::openOutputStream(fileName);
+    if (!f.is_open())
+    {
+      err("Could not open file %s for writing the trace\n",qPrint(fileName));
+      return;
+    }
+    std::ostream &t = f;
+    t << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first=true;
+    uint32_t pid = Portable::pid();
+    for (const auto &e : events)
+    {
+      if (!first) t << ",\n";
+      first=false;
+      switch (e.kind)
+      {
+        case TraceEvent::Kind::Span:
+          t << "{\"ph\":\"X\",\"cat\":\"" << e.category << "\",\"name\":";
+          writeJsonString(t,e.name);
+          t << ",\"pid\":" << pid << ",\"tid\":" << e.tid << ",\"ts\":" << e.ts << ",\"dur\":" << e.dur << "}";
+          break;
+        case TraceEvent::Kind::Counter:
+          t << "{\"ph\":\"C\",\"cat\":\"" << e.category << "\",\"name\":";
+          writeJsonString(t,e.name);
+          t << ",\"pid\":" << pid << ",\"tid\":" << e.tid << ",\"ts\":" << e.ts << ",\"args\":{\"value\":" << e.value << "}}";
+          break;
+        case TraceEvent::Kind::ThreadName:
+          t << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid << ",\"tid\":" << e.tid << ",\"args\":{\"name\":";
+          writeJsonString(t,e.name);
+          t << "}}";
+          break;
+      }
+    }
+    t << "\n]}\n";
+  }
+};
+
+ChromeTrace::ChromeTrace() : p(std::make_unique<Private>())
+{
+}
+
+ChromeTrace::~ChromeTrace()
+{
+  stop();
+}
+
+ChromeTrace &ChromeTrace::instance()
+{
+  static ChromeTrace trace;
+  return trace;
+}
+
+void ChromeTrace::start(const QCString &fileName)
+{
+  if (m_enabled) return;
+  p->fileName  = fileName;
+  p->startTime = Clock::now();
+  p->events.clear();
+  p->stopSampler = false;
+  m_enabled = true;
+  setThreadName("main");
+  p->sampler = std::thread([this]() { p->sampleMemory(); });
+}
+
+void ChromeTrace::stop()
+{
+  if (!m_enabled) return;
+  {
+    std::lock_guard<std::mutex> lock(p->samplerMutex);
+    p->stopSampler = true;
+  }
+  p->samplerCond.notify_one();
+  p->sampler.join();
+  m_enabled = false;
+  std::lock_guard<std::mutex> lock(p->mutex);
+  p->write();
+  p->events.clear();
+}
+
+void ChromeTrace::setThreadName(const QCString &name)
+{
+  if (!m_enabled) return;
+  p->addEvent({TraceEvent::Kind::ThreadName,"",name,traceThreadId(),0,0,0.0});
+}
+
+void ChromeTrace::addSpan(const char *category,const QCString &name,Clock::time_point start,Clock::time_point end)
+{
+  if (!m_enabled) return;
+  int64_t ts = p->toMicroSeconds(start);
+  p->addEvent({TraceEvent::Kind::Span,category,name,traceThreadId(),ts,p->toMicroSeconds(end)-ts,0.0});
+}
+
+//---------------------------------------------------------------------------------------------
+
+ChromeTrace::Span::Span(const char *category,const QCString &name)
+  : m_active(ChromeTrace::instance().isEnabled()), m_category(category)
+{
+  if (m_active)
+  {
+    m_name  = name;
+    m_start = Clock::now();
+  }
+}
+
+ChromeTrace::Span::~Span()
+{
+  if (m_active)
+  {
+    ChromeTrace::instance().addSpan(m_category,m_name,m_start,Clock::now());
+  }
+}
@@ -0,0 +1,79 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef CHROMETRACE_H
+#define CHROMETRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include "qcstring.h"
+#include "construct.h"
+
+/** @brief Collects profiling events and writes them in the Chrome trace event format.
+ *
+ *  Tracing is enabled with the \c -d \c trace=<file> command line option.
+ *  The resulting JSON file can be loaded in \c chrome://tracing or
+ *  <a href="https://ui.perfetto.dev">Perfetto</a>. Besides the spans recorded
+ *  via the Span class, the resident memory size of the process is sampled
+ *  periodically while tracing is enabled.
+ */
+class ChromeTrace
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static ChromeTrace &instance();
+
+    /** Starts collecting events, which will be written to \a fileName when stop() is called. */
+    void start(const QCString &fileName);
+
+    /** Stops collecting events and writes the trace file. Does nothing if tracing is not enabled. */
+    void stop();
+
+    /** Returns TRUE if events are being collected. */
+    bool isEnabled() const { return m_enabled; }
+
+    /** Sets the name under which the calling thread is shown in the trace. */
+    void setThreadName(const QCString &name);
+
+    /** Records a span of category \a category named \a name for the calling thread. */
+    void addSpan(const char *category,const QCString &name,Clock::time_point start,Clock::time_point end);
+
+    /** @brief Records a span for the calling thread from construction until destruction. */
+    class Span
+    {
+      public:
+        Span(const char *category,const QCString &name);
+       ~Span();
+        NON_COPYABLE(Span)
+      private:
+        bool m_active;
+        const char *m_category;
+        QCString m_name;
+        Clock::time_point m_start;
+    };
+
+  private:
+    ChromeTrace();
+   ~ChromeTrace();
+    NON_COPYABLE(ChromeTrace)
+    std::atomic<bool> m_enabled = false;
+    struct Private;
+    std::unique_ptr<Private> p;
+};
+
+#endif
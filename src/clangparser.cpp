@@ -2,8 +2,11 @@
 #include "settings.h"
 #include <cstdio>
 #include <cstdint>
+#include <algorithm>
 #include <vector>
+#include <list>
 #include <mutex>
+#include <atomic>
 
 #if USE_LIBCLANG
 #include <clang-c/Index.h>
@@ -63,6 +66,22 @@ static const char * keywordToType(const char *keyword)
 }
 
 
+/** Returns TRUE if the compile command \a options for file \a fileName compile it as C++,
+ *  which is what the precompiled header is built for.
+ */
+static bool isCppCommand(const std::vector<std::string> &options,const QCString &fileName)
+{
+  for (size_t i=options.size(); i>0; i--) // the last -x option wins
+  {
+    const std::string &opt = options[i-1];
+    if (opt=="-x" && i<options.size()) return options[i].rfind("c++",0)==0;
+    if (opt.rfind("-x",0)==0 && opt.size()>2) return opt.compare(2,3,"c++")==0;
+  }
+  QCString fn = fileName.lower();
+  return fn.endsWith(".cpp") || fn.endsWith(".cxx") || fn.endsWith(".cc") || fn.endsWith(".c++") ||
+         fn.endsWith(".hpp") || fn.endsWith(".hxx") || fn.endsWith(".hh");
+}
+
 //--------------------------------------------------------------------------
 
 class ClangTUParser::Private
@@ -109,6 +128,7 @@ StringVector ClangTUParser::filesInSameTU() const
 void ClangTUParser::parse()
 {
   //printf("ClangTUParser::parse() this=%p\n",this);
+  if (p->tu) return; // translation unit kept from an earlier pass
   QCString fileName = p->fileDef->absFilePath();
   p->fileDef->getAllIncludeFilesRecursively(p->filesInSameTU);
   //printf("ClangTUParser::ClangTUParser(fileName=%s,#filesInSameTU=%d)\n",
@@ -119,6 +139,7 @@ void ClangTUParser::parse()
   const StringVector &includePath = Config_getList(INCLUDE_PATH);
   const StringVector &clangOptions = Config_getList(CLANG_OPTIONS);
   if (!clangAssistedParsing) return;
+  QCString pchFile = p->parser.precompiledHeader();
   //printf("ClangParser::start(%s)\n",fileName);
   assert(p->index==nullptr);
   assert(p->tokens==nullptr);
@@ -133,6 +154,8 @@ void ClangTUParser::parse()
     command = p->parser.database()->getCompileCommands(fileName.data());
   }
   std::vector<char *> argv;
+  bool usePch = false;
+  size_t pchArg = 0; // position of the -include-pch option in argv if usePch is set
   if (!command.empty() )
   {
     std::vector<std::string> options = command[command.size()-1].CommandLine;
@@ -162,6 +185,13 @@ void ClangTUParser::parse()
     {
       argv.push_back(qstrdup(clangOptions[i].c_str()));
     }
+    if (!pchFile.isEmpty() && isCppCommand(options,fileName)) // the header is precompiled as C++
+    {
+      usePch = true;
+      pchArg = argv.size();
+      argv.push_back(qstrdup("-include-pch"));
+      argv.push_back(qstrdup(pchFile.data()));
+    }
     // this extra addition to argv is accounted for as we are skipping the first entry in
     argv.push_back(qstrdup("-w")); // finally, turn off warnings.
   }
@@ -227,6 +257,13 @@ void ClangTUParser::parse()
       case DetectedLang::ObjC:   argv.push_back(qstrdup("objective-c"));   break;
       case DetectedLang::ObjCpp: argv.push_back(qstrdup("objective-c++")); break;
     }
+    if (!pchFile.isEmpty() && p->detectedLang==DetectedLang::Cpp) // the header is precompiled as C++
+    {
+      usePch = true;
+      pchArg = argv.size();
+      argv.push_back(qstrdup("-include-pch"));
+      argv.push_back(qstrdup(pchFile.data()));
+    }
   }
   //printf("source %s ----------\n%s\n-------------\n\n",
   //    fileName,p->source.data());
@@ -257,6 +294,15 @@ void ClangTUParser::parse()
   p->tu = clang_parseTranslationUnit(p->index, fileName.data(),
                                      argv.data(), static_cast<int>(argv.size()), p->ufs.data(), numUnsavedFiles,
                                      CXTranslationUnit_DetailedPreprocessingRecord);
+  if (p->tu==nullptr && usePch) // the precompiled header may not fit this unit, try again without it
+  {
+    qstrfree(argv[pchArg]);
+    qstrfree(argv[pchArg+1]);
+    argv.erase(argv.begin()+pchArg,argv.begin()+pchArg+2);
+    p->tu = clang_parseTranslationUnit(p->index, fileName.data(),
+                                       argv.data(), static_cast<int>(argv.size()), p->ufs.data(), numUnsavedFiles,
+                                       CXTranslationUnit_DetailedPreprocessingRecord);
+  }
   //printf("  tu=%p\n",p->tu);
   // free arguments
   for (i=0;i<argv.size();++i)
@@ -284,6 +330,25 @@ void ClangTUParser::parse()
   }
 }
 
+size_t ClangTUParser::memoryUsage() const
+{
+  size_t size = 0;
+  if (p->tu)
+  {
+    CXTUResourceUsage usage = clang_getCXTUResourceUsage(p->tu);
+    for (unsigned i=0; i<usage.numEntries; i++)
+    {
+      size+=usage.entries[i].amount;
+    }
+    clang_disposeCXTUResourceUsage(usage);
+  }
+  for (const auto &s : p->sources)
+  {
+    size+=s.length();
+  }
+  return size;
+}
+
 ClangTUParser::~ClangTUParser()
 {
   //printf("ClangTUParser::~ClangTUParser() this=%p\n",this);
@@ -927,7 +992,70 @@ class ClangParser::Private
       }
     }
 
+    void buildPrecompiledHeader()
+    {
+      QCString header = Config_getString(CLANG_PRECOMPILED_HEADER);
+      if (header.isEmpty()) return;
+      StringVector args;
+      if (Config_getBool(CLANG_ADD_INC_PATHS))
+      {
+        for (const std::string &path : Doxygen::inputPaths)
+        {
+          args.push_back("-I"+path);
+        }
+      }
+      for (const auto &path : Config_getList(INCLUDE_PATH))
+      {
+        args.push_back("-I"+path);
+      }
+      for (const auto &option : Config_getList(CLANG_OPTIONS))
+      {
+        args.push_back(option);
+      }
+      args.push_back("-w");
+      args.push_back("-x");
+      args.push_back("c++-header");
+      std::vector<const char *> argv;
+      for (const auto &arg : args)
+      {
+        argv.push_back(arg.c_str());
+      }
+      QCString fileName = Config_getString(OUTPUT_DIRECTORY)+"/doxygen_clang.pch";
+      msg("Precompiling header %s...\n",qPrint(header));
+      CXIndex index = clang_createIndex(0, 0);
+      CXTranslationUnit tu = clang_parseTranslationUnit(index, header.data(),
+                                 argv.data(), static_cast<int>(argv.size()), nullptr, 0,
+                                 CXTranslationUnit_ForSerialization | CXTranslationUnit_Incomplete);
+      if (tu && clang_saveTranslationUnit(tu,fileName.data(),clang_defaultSaveOptions(tu))==CXSaveError_None)
+      {
+        pchFile = fileName;
+      }
+      else
+      {
+        err("clang: Failed to precompile header %s\n",qPrint(header));
+      }
+      if (tu) clang_disposeTranslationUnit(tu);
+      clang_disposeIndex(index);
+    }
+
     std::unique_ptr<clang::tooling::CompilationDatabase> db;
+
+    // precompiled header, built on first use
+    std::once_flag pchOnce;
+    QCString pchFile;
+
+    // translation units kept between the parsing and the source generation passes
+    struct CachedTU
+    {
+      std::string file;
+      std::unique_ptr<ClangTUParser> parser;
+      size_t size;
+    };
+    std::mutex cacheMutex;
+    std::list<CachedTU> cache; // in the order they were kept
+    size_t cacheSize = 0;
+    std::atomic<size_t> cacheKept = 0;
+    std::atomic<size_t> cacheHits = 0;
 };
 
 const clang::tooling::CompilationDatabase *ClangParser::database() const
@@ -943,12 +1071,83 @@ ClangParser::~ClangParser()
 {
 }
 
+QCString ClangParser::precompiledHeader() const
+{
+  std::call_once(p->pchOnce,[this]() { p->buildPrecompiledHeader(); });
+  return p->pchFile;
+}
+
 std::unique_ptr<ClangTUParser> ClangParser::createTUParser(const FileDef *fd) const
 {
   //printf("ClangParser::createTUParser()\n");
+  if (Config_getInt(CLANG_TU_CACHE_MEMORY)>0)
+  {
+    std::unique_ptr<ClangTUParser> parser;
+    {
+      std::lock_guard<std::mutex> lock(p->cacheMutex);
+      auto it = std::find_if(p->cache.begin(),p->cache.end(),
+                             [&fd](const auto &entry) { return entry.file==fd->absFilePath().str(); });
+      if (it!=p->cache.end())
+      {
+        parser = std::move(it->parser);
+        p->cacheSize-=it->size;
+        p->cache.erase(it);
+      }
+    }
+    if (parser)
+    {
+      // the headers of the file could have changed since the unit was parsed
+      StringVector filesInSameTU;
+      fd->getAllIncludeFilesRecursively(filesInSameTU);
+      if (filesInSameTU==parser->p->filesInSameTU)
+      {
+        p->cacheHits++;
+        return parser;
+      }
+    }
+  }
   return std::make_unique<ClangTUParser>(*this,fd);
 }
 
+void ClangParser::keepTUParser(std::unique_ptr<ClangTUParser> parser) const
+{
+  size_t maxSize = static_cast<size_t>(Config_getInt(CLANG_TU_CACHE_MEMORY))*1024*1024;
+  if (maxSize==0 || !parser || !parser->p->tu) return;
+  // the tokens of the current file are created again by switchToFile()
+  parser->p->cursors.clear();
+  clang_disposeTokens(parser->p->tu,parser->p->tokens,parser->p->numTokens);
+  parser->p->tokens    = nullptr;
+  parser->p->numTokens = 0;
+  size_t size = parser->memoryUsage();
+  // keep the first units that fit; once the cache is full new units are refused rather than
+  // evicting kept ones, as the units are requested again in about the order they were kept
+  {
+    std::lock_guard<std::mutex> lock(p->cacheMutex);
+    if (p->cacheSize+size<=maxSize)
+    {
+      std::string file = parser->p->fileDef->absFilePath().str();
+      p->cache.push_back(Private::CachedTU{file,std::move(parser),size});
+      p->cacheSize+=size;
+      p->cacheKept++;
+    }
+  }
+  // a refused parser is disposed here, after unlocking
+}
+
+void ClangParser::clearTUCache() const
+{
+  std::list<Private::CachedTU> cache;
+  {
+    std::lock_guard<std::mutex> lock(p->cacheMutex);
+    std::swap(cache,p->cache);
+    p->cacheSize=0;
+  }
+  if (p->cacheKept>0)
+  {
+    msg("Reused %zu of %zu kept clang translation units\n",p->cacheHits.load(),p->cacheKept.load());
+  }
+}
+
 
 //--------------------------------------------------------------------------
 #else // use stubbed functionality in case libclang support is disabled.
@@ -995,6 +1194,14 @@ std::unique_ptr<ClangTUParser> ClangParser::createTUParser(const FileDef *) cons
   return nullptr;
 }
 
+void ClangParser::keepTUParser(std::unique_ptr<ClangTUParser>) const
+{
+}
+
+void ClangParser::clearTUCache() const
+{
+}
+
 #endif
 //--------------------------------------------------------------------------
 
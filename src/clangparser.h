@@ -23,6 +23,7 @@ namespace clang { namespace tooling {
  */
 class ClangTUParser
 {
+    friend class ClangParser;
   public:
     ClangTUParser(const ClangParser &parser,const FileDef *fd);
     NON_COPYABLE(ClangTUParser)
@@ -30,6 +31,7 @@ class ClangTUParser
 
     /** Parse the file given at construction time as a translation unit
      *  This file should already be preprocessed by doxygen preprocessor at the time of calling.
+     *  Does nothing if the translation unit was already parsed before.
      */
     void parse();
 
@@ -53,6 +55,7 @@ class ClangTUParser
     void writeSources(OutputCodeList &ol,const FileDef *fd);
 
   private:
+    size_t memoryUsage() const;
     void detectFunctionBody(const char *s);
     void writeLineNumber(OutputCodeList &ol,const FileDef *fd,uint32_t line,bool writeLineAnchor);
     void codifyLines(OutputCodeList &ol,const FileDef *fd,const char *text,
@@ -82,10 +85,23 @@ class ClangParser
   public:
     /** Returns the one and only instance of the class */
     static ClangParser *instance();
+
+    /** Returns a parser for the translation unit of \a fd. This is the translation unit
+     *  kept by keepTUParser() if there is one for the same file with the same headers.
+     */
     std::unique_ptr<ClangTUParser> createTUParser(const FileDef *fd) const;
 
+    /** Keeps the parsed translation unit of \a parser for a later createTUParser() call,
+     *  as long as the memory set with CLANG_TU_CACHE_MEMORY allows it.
+     */
+    void keepTUParser(std::unique_ptr<ClangTUParser> parser) const;
+
+    /** Releases all translation units kept by keepTUParser(). */
+    void clearTUCache() const;
+
   private:
     const clang::tooling::CompilationDatabase *database() const;
+    QCString precompiledHeader() const;
     class Private;
     std::unique_ptr<Private> p;
     ClangParser();
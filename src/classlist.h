@@ -23,7 +23,7 @@
 
 class Definition;
 
-class ClassLinkedMap : public LinkedMap<ClassDef>
+class ClassLinkedMap : public AtomLinkedMap<ClassDef>
 {
 };
 
@@ -20,6 +20,8 @@
 
 #include <string>
 
+class StreamPipe;
+
 /** @file
  *  @brief First pass comment processing.
  */
@@ -37,5 +39,12 @@
 void convertCppComments(const std::string &inBuf,std::string &outBuf,
                         const std::string &fn);
 
+/** Converts the comments of a file whose content is read from \a input while it is
+ *  being produced by another thread. Reads until the pipe is closed.
+ *  Not suitable for Fortran, for which the whole file is needed to detect fixed form.
+ */
+void convertCppComments(StreamPipe &input,std::string &outBuf,
+                        const std::string &fn);
+
 #endif
 
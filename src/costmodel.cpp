@@ -0,0 +1,136 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <array>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#include "costmodel.h"
+#include "config.h"
+#include "portable.h"
+#include "message.h"
+
+static const char *g_costFileName = "doxygen_jobcosts.txt";
+static const char *g_costFileHeader = "# doxygen job costs 1";
+static constexpr size_t g_numJobs = 3;
+
+// used when no measurements are available, only the relative order matters in that case
+static constexpr double g_defaultSecondsPerUnit = 1e-6;
+
+struct Measured
+{
+  double seconds;
+  size_t size;
+};
+
+using MeasuredMap = std::unordered_map<std::string,Measured>;
+
+struct CostModel::Private
+{
+  std::mutex mutex;
+  std::array<MeasuredMap,g_numJobs> previous;
+  std::array<MeasuredMap,g_numJobs> current;
+  std::array<double,g_numJobs> secondsPerUnit = { g_defaultSecondsPerUnit, g_defaultSecondsPerUnit, g_defaultSecondsPerUnit };
+
+  static QCString fileName()
+  {
+    return Config_getString(OUTPUT_DIRECTORY)+"/"+g_costFileName;
+  }
+};
+
+CostModel::CostModel() : p(std::make_unique<Private>())
+{
+}
+
+CostModel::~CostModel() = default;
+
+CostModel &CostModel::instance()
+{
+  static CostModel model;
+  return model;
+}
+
+void CostModel::load()
+{
+  std::ifstream f = Portable::openInputStream(Private::fileName());
+  if (!f.is_open()) return;
+  std::string line;
+  if (!std::getline(f,line) || line!=g_costFileHeader) return;
+  std::array<double,g_numJobs> totalSeconds = {};
+  std::array<double,g_numJobs> totalSize    = {};
+  while (std::getline(f,line))
+  {
+    std::istringstream ls(line);
+    size_t job=0, size=0;
+    double seconds=0;
+    std::string key;
+    if (ls >> job >> seconds >> size && job<g_numJobs && std::getline(ls >> std::ws,key))
+    {
+      p->previous[job].emplace(key,Measured{seconds,size});
+      totalSeconds[job]+=seconds;
+      totalSize[job]+=static_cast<double>(size);
+    }
+  }
+  // calibrate the estimates for jobs that were not measured before
+  for (size_t job=0; job<g_numJobs; job++)
+  {
+    if (totalSize[job]>0 && totalSeconds[job]>0)
+    {
+      p->secondsPerUnit[job] = totalSeconds[job]/totalSize[job];
+    }
+  }
+}
+
+void CostModel::save()
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  std::ofstream f = Portable::openOutputStream(Private::fileName());
+  if (!f.is_open()) return;
+  f << g_costFileHeader << "\n";
+  for (size_t job=0; job<g_numJobs; job++)
+  {
+    for (const auto &[key,m] : p->current[job])
+    {
+      f << job << " " << m.seconds << " " << m.size << " " << key << "\n";
+    }
+    // keep the measurements of jobs that did not run this time, e.g. files that were skipped
+    for (const auto &[key,m] : p->previous[job])
+    {
+      if (p->current[job].find(key)==p->current[job].end())
+      {
+        f << job << " " << m.seconds << " " << m.size << " " << key << "\n";
+      }
+    }
+  }
+}
+
+double CostModel::estimate(Job job,const QCString &key,size_t size) const
+{
+  size_t index = static_cast<size_t>(job);
+  const MeasuredMap &prev = p->previous[index];
+  auto it = prev.find(key.str());
+  if (it!=prev.end() && it->second.size==size) // same job as last time
+  {
+    return it->second.seconds;
+  }
+  return static_cast<double>(size)*p->secondsPerUnit[index];
+}
+
+void CostModel::record(Job job,const QCString &key,size_t size,double seconds)
+{
+  std::lock_guard<std::mutex> lock(p->mutex);
+  p->current[static_cast<size_t>(job)][key.str()] = Measured{seconds,size};
+}
@@ -0,0 +1,83 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef COSTMODEL_H
+#define COSTMODEL_H
+
+#include <chrono>
+#include <memory>
+
+#include "qcstring.h"
+#include "construct.h"
+
+/** @brief Estimates how long a job will take, used to order the jobs queued to a thread pool.
+ *
+ *  Queueing the most expensive jobs first avoids a long tail where a single
+ *  thread is still busy with a large job that was queued last. The estimate
+ *  for a job is the time it took in the previous run, when known, and is
+ *  otherwise derived from the size of the job. The measured times are stored
+ *  in the output directory at the end of a run.
+ */
+class CostModel
+{
+  public:
+    /** Kind of job, the measurements of different kinds are kept apart. */
+    enum class Job { Parse, Source, ClassDoc };
+
+    static CostModel &instance();
+
+    /** Reads the measurements of the previous run from the output directory. */
+    void load();
+
+    /** Writes the measurements of this run to the output directory. */
+    void save();
+
+    /** Returns the estimated time in seconds for job \a key of kind \a job,
+     *  where \a size is a measure for the amount of work, such as the file size.
+     */
+    double estimate(Job job,const QCString &key,size_t size) const;
+
+    /** Records that job \a key of kind \a job with size \a size took \a seconds. */
+    void record(Job job,const QCString &key,size_t size,double seconds);
+
+    /** @brief Records the time from construction until destruction. */
+    class Measurement
+    {
+      public:
+        Measurement(Job job,const QCString &key,size_t size)
+          : m_job(job), m_key(key), m_size(size), m_start(std::chrono::steady_clock::now()) {}
+       ~Measurement()
+        {
+          auto elapsed = std::chrono::steady_clock::now()-m_start;
+          CostModel::instance().record(m_job,m_key,m_size,
+              std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count());
+        }
+        NON_COPYABLE(Measurement)
+      private:
+        Job m_job;
+        QCString m_key;
+        size_t m_size;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+  private:
+    CostModel();
+   ~CostModel();
+    NON_COPYABLE(CostModel)
+    struct Private;
+    std::unique_ptr<Private> p;
+};
+
+#endif
@@ -337,6 +337,15 @@ bool Dir::copy(const std::string &srcName,const std::string &dstName,bool accept
   return !ec;
 }
 
+bool Dir::link(const std::string &srcName,const std::string &dstName,bool acceptsAbsPath) const
+{
+  std::error_code ec;
+  std::string sn = filePath(srcName,acceptsAbsPath);
+  std::string dn = filePath(dstName,acceptsAbsPath);
+  fs::create_hard_link(sn,dn,ec);
+  return !ec;
+}
+
 std::string Dir::currentDirPath()
 {
   std::error_code ec;
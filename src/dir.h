@@ -96,6 +96,7 @@ class Dir final
     bool rename(const std::string &orgName,const std::string &newName,
                 bool acceptsAbsPath=true) const;
     bool copy(const std::string &src,const std::string &dest,bool acceptsAbsPath=true) const;
+    bool link(const std::string &src,const std::string &dest,bool acceptsAbsPath=true) const;
     std::string absPath() const;
 
     bool isRelative() const;
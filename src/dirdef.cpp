@@ -31,6 +31,7 @@
 #include "definitionimpl.h"
 #include "filedef.h"
 #include "trace.h"
+#include "threadpool.h"
 
 //----------------------------------------------------------------------
 
@@ -1143,24 +1144,70 @@ void computeDirDependencies()
   }
 }
 
+static void generateDirDoc(DirDef *dir,OutputList &ol)
+{
+  ol.pushGeneratorState();
+  if (!dir->hasDocumentation())
+  {
+    ol.disableAllBut(OutputType::Html);
+  }
+  dir->writeDocumentation(ol);
+  ol.popGeneratorState();
+}
+
 void generateDirDocs(OutputList &ol)
 {
   AUTO_TRACE();
-  for (const auto &dir : *Doxygen::dirLinkedMap)
+  std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
+  if (numThreads>1) // multi threaded processing
   {
-    ol.pushGeneratorState();
-    if (!dir->hasDocumentation())
+    // each directory and each directory relation is written to its own file
+    // using a copy of the output list.
+    struct DocContext
     {
-      ol.disableAllBut(OutputType::Html);
+      DocContext(const OutputList &ol_) : ol(ol_) {}
+      OutputList ol;
+    };
+    ThreadPool threadPool(numThreads,"dirdocs");
+    std::vector< std::future< std::shared_ptr<DocContext> > > results;
+    for (const auto &dir : *Doxygen::dirLinkedMap)
+    {
+      auto ctx = std::make_shared<DocContext>(ol);
+      DirDef *dd = dir.get();
+      results.emplace_back(threadPool.queue([ctx,dd]()
+      {
+        ChromeTrace::Span span("dirdocs",dd->displayName());
+        generateDirDoc(dd,ctx->ol);
+        return ctx;
+      }));
+    }
+    for (const auto &dr : Doxygen::dirRelations)
+    {
+      auto ctx = std::make_shared<DocContext>(ol);
+      DirRelation *rel = dr.get();
+      results.emplace_back(threadPool.queue([ctx,rel]()
+      {
+        rel->writeDocumentation(ctx->ol);
+        return ctx;
+      }));
+    }
+    for (auto &f : results)
+    {
+      auto ctx = threadPool.wait(f);
     }
-    dir->writeDocumentation(ol);
-    ol.popGeneratorState();
   }
-  //if (Config_getBool(DIRECTORY_GRAPH))
+  else // single threaded processing
   {
-    for (const auto &dr : Doxygen::dirRelations)
+    for (const auto &dir : *Doxygen::dirLinkedMap)
+    {
+      generateDirDoc(dir.get(),ol);
+    }
+    //if (Config_getBool(DIRECTORY_GRAPH))
     {
-      dr->writeDocumentation(ol);
+      for (const auto &dr : Doxygen::dirRelations)
+      {
+        dr->writeDocumentation(ol);
+      }
     }
   }
 }
@@ -0,0 +1,340 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <cctype>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "docaststore.h"
+#include "docnodeserializer.h"
+#include "doxygen.h"
+#include "definition.h"
+#include "memberdef.h"
+#include "filedef.h"
+#include "filename.h"
+#include "groupdef.h"
+#include "pagedef.h"
+#include "fileinfo.h"
+#include "section.h"
+#include "symbolmap.h"
+#include "serialization.h"
+#include "parsecache.h"
+#include "message.h"
+#include "md5.h"
+
+// bump this whenever the layout of the file changes, the layout of the nodes has its own version
+static const uint32_t g_formatVersion = 2;
+static const char    *g_magic         = "DOXYGEN_DOC_ASTS";
+static const char    *g_fileName      = "doc_asts.cache";
+
+// commands whose result depends on more than the block itself and the state covered by its fingerprint
+static const char *g_uncacheableCommands[] = { "copydoc", "copybrief", "copydetails", "inheritdoc", "showdate" };
+
+static void appendDefinition(std::string &text,const Definition *d)
+{
+  if (d==nullptr)
+  {
+    text+="-\t";
+    return;
+  }
+  text+=std::to_string(static_cast<int>(d->definitionType()));
+  text+='\t';
+  text+=d->qualifiedName().str();
+  text+='\t';
+  text+=d->getDefFileName().str();
+  text+='\t';
+  text+=std::to_string(d->getDefLine());
+  text+='\t';
+  const MemberDef *md = toMemberDef(d);
+  if (md)
+  {
+    text+=md->argsString().str();
+    text+='\t';
+    text+=md->anchor().str();
+    text+='\t';
+  }
+}
+
+static void appendSymbol(StringVector &lines,const Definition *d)
+{
+  std::string line;
+  appendDefinition(line,d);
+  line+=d->getOutputFileBase().str();
+  line+='\t';
+  line+=d->anchor().str();
+  line+='\t';
+  line+=d->getReference().str();
+  line+='\t';
+  line+=d->displayName().str();
+  line+='\t';
+  line+=d->isLinkable() ? '1' : '0';
+  line+=d->isLinkableInProject() ? '1' : '0';
+  line+='\t';
+  line+=d->briefDescription().str(); // tooltips are derived from it
+  lines.push_back(line);
+}
+
+static void appendFiles(StringVector &lines,const FileNameLinkedMap *fnMap,const std::string &name)
+{
+  const FileName *fn = fnMap ? fnMap->find(name) : nullptr;
+  if (fn==nullptr) return;
+  for (const auto &fd : *fn)
+  {
+    FileInfo fi(fd->absFilePath().str());
+    lines.push_back(fd->absFilePath().str()+"\t"+std::to_string(fi.size())+"\t"+std::to_string(fi.lastModified()));
+  }
+}
+
+static bool isNameChar(char c)
+{
+  return isalnum(static_cast<unsigned char>(c)) || c=='_' || (c&0x80);
+}
+
+static bool isWordChar(char c)
+{
+  return isNameChar(c) || c==':' || c=='.' || c=='-' || c=='/' || c=='~' || c=='#';
+}
+
+// Parsing a block resolves the words in it against symbols, pages, groups, sections and
+// files. The state of everything a word of the block could have resolved to is part of
+// the fingerprint, so a change elsewhere in the project only invalidates the blocks
+// that mention it. Identifiers are looked up in the symbol map, complete words such as
+// section labels and file names in the other maps.
+static std::string computeFingerprint(const QCString &input)
+{
+  StringSet names;
+  StringSet words;
+  const char *s = input.data();
+  size_t len = input.length();
+  size_t i=0;
+  while (i<len)
+  {
+    if (!isWordChar(s[i])) { i++; continue; }
+    size_t start=i;
+    while (i<len && isWordChar(s[i])) i++;
+    size_t end=i;
+    while (end>start && !isNameChar(s[end-1])) end--; // strip trailing punctuation
+    if (end==start) continue;
+    std::string word(s+start,end-start);
+    for (size_t j=0; j<word.size();)
+    {
+      if (!isNameChar(word[j])) { j++; continue; }
+      size_t k=j;
+      while (k<word.size() && isNameChar(word[k])) k++;
+      names.insert(word.substr(j,k-j));
+      j=k;
+    }
+    words.insert(word);
+  }
+
+  StringVector lines;
+  for (const auto &name : names)
+  {
+    lines.push_back("N\t"+name);
+    for (const Definition *d : Doxygen::symbolMap->find(QCString(name)))
+    {
+      appendSymbol(lines,d);
+    }
+  }
+  for (const auto &word : words)
+  {
+    lines.push_back("W\t"+word);
+    const SectionInfo *si = SectionManager::instance().find(word);
+    if (si)
+    {
+      lines.push_back(si->label().str()+"\t"+si->title().str()+"\t"+si->fileName().str()+"\t"+
+                      si->ref().str()+"\t"+std::to_string(si->type().level())+"\t"+std::to_string(si->level()));
+    }
+    if (const Definition *d = Doxygen::pageLinkedMap->find(word))     appendSymbol(lines,d);
+    if (const Definition *d = Doxygen::exampleLinkedMap->find(word))  appendSymbol(lines,d);
+    if (const Definition *d = Doxygen::groupLinkedMap->find(word))    appendSymbol(lines,d);
+    size_t sep = word.rfind('/');
+    std::string baseName = sep==std::string::npos ? word : word.substr(sep+1);
+    appendFiles(lines,Doxygen::inputNameLinkedMap,baseName);
+    appendFiles(lines,Doxygen::exampleNameLinkedMap,baseName);
+    appendFiles(lines,Doxygen::imageNameLinkedMap,baseName);
+    appendFiles(lines,Doxygen::dotFileNameLinkedMap,baseName);
+    appendFiles(lines,Doxygen::mscFileNameLinkedMap,baseName);
+    appendFiles(lines,Doxygen::diaFileNameLinkedMap,baseName);
+    appendFiles(lines,Doxygen::plantUmlFileNameLinkedMap,baseName);
+  }
+
+  std::string text;
+  for (const auto &line : lines)
+  {
+    text+=line;
+    text+='\n';
+  }
+  uint8_t md5_sig[16];
+  char sigStr[33];
+  MD5Buffer(text.data(),static_cast<unsigned int>(text.size()),md5_sig);
+  MD5SigToString(md5_sig,sigStr);
+  return sigStr;
+}
+
+//---------------------------------------------------------------------------------------------
+
+struct DocAstStore::Private
+{
+  struct Entry
+  {
+    std::string fingerprint; // see computeFingerprint()
+    std::string ast;
+  };
+  using EntryMap = std::unordered_map<std::string,Entry>;
+
+  bool                enabled = false;
+  std::string         configFingerprint;
+  EntryMap            previous; // read-only after load()
+  std::mutex          mutex;
+  EntryMap            current;  // entries to write in save()
+  std::atomic<size_t> restored = 0;
+  std::atomic<size_t> stored   = 0;
+};
+
+DocAstStore::DocAstStore() : p(std::make_unique<Private>())
+{
+}
+
+DocAstStore::~DocAstStore() = default;
+
+DocAstStore &DocAstStore::instance()
+{
+  static DocAstStore store;
+  return store;
+}
+
+void DocAstStore::load()
+{
+  if (!ParseCache::instance().isEnabled()) return;
+  p->configFingerprint = ParseCache::configFingerprint();
+  p->enabled           = true;
+
+  std::string data;
+  if (!ParseCache::instance().readCacheFile(g_fileName,data)) return;
+  Deserializer d(data);
+  if (d.readString()!=g_magic || d.readUInt()!=g_formatVersion ||
+      d.readUInt()!=DocNodeSerializer::formatVersion() || d.readString()!=p->configFingerprint)
+  {
+    return;
+  }
+  size_t count = d.readSize();
+  for (size_t i=0; i<count && !d.failed(); i++)
+  {
+    std::string key = d.readString();
+    Private::Entry e;
+    e.fingerprint = d.readString();
+    e.ast         = d.readString();
+    p->previous.emplace(std::move(key),std::move(e));
+  }
+  if (d.failed()) p->previous.clear();
+}
+
+void DocAstStore::save()
+{
+  if (!p->enabled) return;
+  std::lock_guard<std::mutex> lock(p->mutex);
+  Serializer s;
+  s.writeString(std::string(g_magic));
+  s.writeUInt(g_formatVersion);
+  s.writeUInt(DocNodeSerializer::formatVersion());
+  s.writeString(p->configFingerprint);
+  s.writeSize(p->current.size());
+  for (const auto &[key,e] : p->current)
+  {
+    s.writeString(key);
+    s.writeString(e.fingerprint);
+    s.writeString(e.ast);
+  }
+  ParseCache::instance().writeCacheFile(g_fileName,s.data());
+  p->previous.clear();
+  p->current.clear();
+  p->enabled = false;
+}
+
+bool DocAstStore::isEnabled() const
+{
+  return p->enabled;
+}
+
+std::string DocAstStore::key(const QCString &fileName,int startLine,
+                             const Definition *ctx,const MemberDef *md,
+                             const QCString &input,bool isExample,const QCString &exampleName,
+                             bool singleLine,bool linkFromIndex,bool markdownSupport)
+{
+  for (const char *cmd : g_uncacheableCommands)
+  {
+    if (input.find(cmd)!=-1) return std::string();
+  }
+  uint8_t md5_sig[16];
+  char sigStr[33];
+  MD5Buffer(input.data(),static_cast<unsigned int>(input.length()),md5_sig);
+  MD5SigToString(md5_sig,sigStr);
+  std::string result = sigStr;
+  result+='\t';
+  appendDefinition(result,ctx);
+  appendDefinition(result,md);
+  result+=fileName.str();
+  result+='\t';
+  result+=std::to_string(startLine);
+  result+='\t';
+  result+=isExample      ? '1' : '0';
+  result+=singleLine     ? '1' : '0';
+  result+=linkFromIndex  ? '1' : '0';
+  result+=markdownSupport? '1' : '0';
+  result+='\t';
+  result+=exampleName.str();
+  return result;
+}
+
+std::string DocAstStore::fingerprint(const QCString &input)
+{
+  return computeFingerprint(input);
+}
+
+IDocNodeASTPtr DocAstStore::find(const std::string &key,const std::string &fingerprint,const Definition *ctx,const MemberDef *md)
+{
+  if (!p->enabled) return nullptr;
+  auto it = p->previous.find(key);
+  if (it==p->previous.end() || it->second.fingerprint!=fingerprint) return nullptr;
+  Deserializer d(it->second.ast);
+  IDocNodeASTPtr ast = DocNodeSerializer::deserialize(d,ctx,md);
+  if (ast)
+  {
+    std::lock_guard<std::mutex> lock(p->mutex);
+    p->current.emplace(key,it->second);
+    p->restored++;
+  }
+  return ast;
+}
+
+void DocAstStore::store(const std::string &key,const std::string &fingerprint,const IDocNodeAST &ast,
+                        const Definition *ctx,const MemberDef *md)
+{
+  if (!p->enabled) return;
+  Serializer s;
+  if (DocNodeSerializer::serialize(s,ast,ctx,md))
+  {
+    std::lock_guard<std::mutex> lock(p->mutex);
+    if (p->current.emplace(key,Private::Entry{fingerprint,s.data()}).second) p->stored++;
+  }
+}
+
+void DocAstStore::printStatistics() const
+{
+  if (!p->enabled) return;
+  msg("Documentation AST store: restored %zu blocks, stored %zu blocks.\n",p->restored.load(),p->stored.load());
+}
@@ -0,0 +1,96 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef DOCASTSTORE_H
+#define DOCASTSTORE_H
+
+#include <memory>
+#include <string>
+
+#include "qcstring.h"
+#include "construct.h"
+#include "docparser.h"
+
+class Definition;
+class MemberDef;
+
+/** @brief Persistent store of the documentation ASTs produced by earlier runs.
+ *
+ *  When the parse cache is enabled (see \c PARSE_CACHE_DIR), the ASTs of the
+ *  documentation blocks parsed while generating the output are stored in the
+ *  cache directory in binary form, see DocNodeSerializer. A later run then
+ *  renders the blocks that did not change from the stored ASTs instead of
+ *  parsing them again.
+ *
+ *  Since parsing resolves links to other definitions, each AST is stored with
+ *  a fingerprint of what the words of its block can refer to: the link targets
+ *  and brief descriptions of the symbols, pages and groups with those names, the
+ *  sections with those labels, and the input, example, image and diagram files
+ *  with those names. A stored AST is only used when the fingerprint computed for
+ *  the block in the current run is the same, so a change only invalidates the
+ *  blocks that mention what changed. A change of the configuration invalidates
+ *  all stored ASTs.
+ *
+ *  Blocks containing images, formulas, citations or cross reference items are
+ *  not stored and are always parsed again, since parsing them also updates
+ *  global state (images are copied to the output directory, the others are
+ *  registered in global lists), see DocNodeSerializer.
+ */
+class DocAstStore
+{
+  public:
+    static DocAstStore &instance();
+
+    /** Reads the ASTs stored by an earlier run, if the configuration did not change. */
+    void load();
+
+    /** Writes the ASTs that were used or added during this run and releases them. */
+    void save();
+
+    /** Returns TRUE if load() was called and the store is in use. */
+    bool isEnabled() const;
+
+    /** Returns the key for a documentation block parsed with the given arguments of
+     *  validatingParseDoc(), or an empty string if the block should not be stored.
+     */
+    static std::string key(const QCString &fileName,int startLine,
+                           const Definition *ctx,const MemberDef *md,
+                           const QCString &input,bool isExample,const QCString &exampleName,
+                           bool singleLine,bool linkFromIndex,bool markdownSupport);
+
+    /** Returns the fingerprint of the state the documentation block \a input depends on. */
+    static std::string fingerprint(const QCString &input);
+
+    /** Returns the AST stored for \a key, or nullptr if there is none or if it was
+     *  stored with a different \a fingerprint.
+     */
+    IDocNodeASTPtr find(const std::string &key,const std::string &fingerprint,const Definition *ctx,const MemberDef *md);
+
+    /** Stores \a ast for \a key with \a fingerprint, if the tree can be serialized. */
+    void store(const std::string &key,const std::string &fingerprint,const IDocNodeAST &ast,
+               const Definition *ctx,const MemberDef *md);
+
+    /** Reports the number of restored and stored ASTs. */
+    void printStatistics() const;
+
+  private:
+    DocAstStore();
+   ~DocAstStore();
+    NON_COPYABLE(DocAstStore)
+    struct Private;
+    std::unique_ptr<Private> p;
+};
+
+#endif
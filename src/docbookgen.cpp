@@ -299,6 +299,7 @@ DocbookGenerator::DocbookGenerator(const DocbookGenerator &og) : OutputGenerator
   m_inLevel          = og.m_inLevel;
   m_firstMember      = og.m_firstMember;
   m_openSectionCount = og.m_openSectionCount;
+  m_pageLinks        = og.m_pageLinks;
 }
 
 DocbookGenerator &DocbookGenerator::operator=(const DocbookGenerator &og)
@@ -319,6 +320,7 @@ DocbookGenerator &DocbookGenerator::operator=(const DocbookGenerator &og)
     m_inLevel          = og.m_inLevel;
     m_firstMember      = og.m_firstMember;
     m_openSectionCount = og.m_openSectionCount;
+    m_pageLinks        = og.m_pageLinks;
   }
   return *this;
 }
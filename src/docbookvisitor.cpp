@@ -13,6 +13,8 @@
  *
  */
 
+#include <atomic>
+
 #include "docbookvisitor.h"
 #include "docparser.h"
 #include "language.h"
@@ -375,15 +377,16 @@ DB_VIS_C
       break;
     case DocVerbatim::Dot:
       {
-        static int dotindex = 1;
+        static std::atomic<int> dotindex = 1;
         QCString baseName(4096, QCString::ExplicitSize);
         QCString name;
         QCString stext = s.text();
         m_t << "<para>\n";
-        name.sprintf("%s%d", "dot_inline_dotgraph_", dotindex);
+        int index = dotindex++;
+        name.sprintf("%s%d", "dot_inline_dotgraph_", index);
         baseName.sprintf("%s%d",
             qPrint(Config_getString(DOCBOOK_OUTPUT)+"/inline_dotgraph_"),
-            dotindex++
+            index
             );
         QCString fileName = baseName+".dot";
         std::ofstream file = Portable::openOutputStream(fileName);
@@ -400,15 +403,16 @@ DB_VIS_C
       break;
     case DocVerbatim::Msc:
       {
-        static int mscindex = 1;
+        static std::atomic<int> mscindex = 1;
         QCString baseName(4096, QCString::ExplicitSize);
         QCString name;
         QCString stext = s.text();
         m_t << "<para>\n";
-        name.sprintf("%s%d", "msc_inline_mscgraph_", mscindex);
+        int index = mscindex++;
+        name.sprintf("%s%d", "msc_inline_mscgraph_", index);
         baseName.sprintf("%s%d",
             (Config_getString(DOCBOOK_OUTPUT)+"/inline_mscgraph_").data(),
-            mscindex++
+            index
             );
         QCString fileName = baseName+".msc";
         std::ofstream file = Portable::openOutputStream(fileName);
@@ -36,6 +36,10 @@
 class MemberDef;
 class Definition;
 class DocParser;
+class DocNodeSerializer;
+
+/** Tag selecting the constructor of a node that is filled in afterwards by DocNodeSerializer. */
+struct DocNodeRestoreTag {};
 
 //---------------------------------------------------------------------------
 
@@ -79,6 +83,7 @@ DOC_NODES
 /** Abstract node interface with type information. */
 class DocNode
 {
+    friend class DocNodeSerializer;
   public:
     /*! Creates a new node */
     DocNode(DocParser *parser,DocNodeVariant *parent) : m_parser(parser), m_parent(parent) {}
@@ -136,6 +141,7 @@ struct DocNodeList : public GrowVector<DocNodeVariant>
 /** Base class for nodes with children */
 class DocCompoundNode : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
     DocCompoundNode(DocParser *parser,DocNodeVariant *parent)
       : DocNode(parser,parent) {}
@@ -150,8 +156,10 @@ class DocCompoundNode : public DocNode
  */
 class DocWord : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
     DocWord(DocParser *parser,DocNodeVariant *parent,const QCString &word);
+    DocWord(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     QCString word() const { return m_word; }
 
   private:
@@ -162,10 +170,12 @@ class DocWord : public DocNode
  */
 class DocLinkedWord : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
     DocLinkedWord(DocParser *parser,DocNodeVariant *parent,const QCString &word,
                   const QCString &ref,const QCString &file,
                   const QCString &anchor,const QCString &tooltip);
+    DocLinkedWord(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     QCString word() const       { return m_word; }
     QCString file() const       { return m_file; }
     QCString relPath() const    { return m_relPath; }
@@ -185,7 +195,9 @@ class DocLinkedWord : public DocNode
 /** Node representing a URL (or email address) */
 class DocURL : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocURL(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     DocURL(DocParser *parser,DocNodeVariant *parent,const QCString &url,bool isEmail) :
       DocNode(parser,parent), m_url(url), m_isEmail(isEmail) {}
     QCString url() const        { return m_url; }
@@ -199,7 +211,9 @@ class DocURL : public DocNode
 /** Node representing a line break */
 class DocLineBreak : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocLineBreak(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     DocLineBreak(DocParser *parser,DocNodeVariant *parent) : DocNode(parser,parent) {}
     DocLineBreak(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs)
       : DocNode(parser,parent), m_attribs(attribs) {}
@@ -213,7 +227,9 @@ class DocLineBreak : public DocNode
 /** Node representing a horizontal ruler */
 class DocHorRuler : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocHorRuler(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     DocHorRuler(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs)
       : DocNode(parser,parent), m_attribs(attribs) {}
 
@@ -226,8 +242,10 @@ class DocHorRuler : public DocNode
 /** Node representing an anchor */
 class DocAnchor : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
     DocAnchor(DocParser *parser,DocNodeVariant *parent,const QCString &id,bool newAnchor);
+    DocAnchor(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     QCString anchor() const    { return m_anchor; }
     QCString file() const      { return m_file; }
 
@@ -242,8 +260,10 @@ class DocAnchor : public DocNode
 /** Node representing a citation of some bibliographic reference */
 class DocCite : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
     DocCite(DocParser *parser,DocNodeVariant *parent,const QCString &target,const QCString &context);
+    DocCite(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     QCString file() const        { return m_file; }
     QCString relPath() const     { return m_relPath; }
     QCString ref() const         { return m_ref; }
@@ -262,6 +282,7 @@ class DocCite : public DocNode
 /** Node representing a style change */
 class DocStyleChange : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
     enum Style { Bold          = (1<<0),
                  Italic        = (1<<1),
@@ -281,6 +302,7 @@ class DocStyleChange : public DocNode
                  Cite          = (1<<15)
                };
 
+    DocStyleChange(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     DocStyleChange(DocParser *parser,DocNodeVariant *parent,size_t position,Style s,
                    const QCString &tagName,bool enable, const HtmlAttribList *attribs=nullptr)
       : DocNode(parser,parent), m_position(position), m_style(s), m_enable(enable)
@@ -306,7 +328,9 @@ class DocStyleChange : public DocNode
 /** Node representing a special symbol */
 class DocSymbol : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocSymbol(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     DocSymbol(DocParser *parser,DocNodeVariant *parent,HtmlEntityMapper::SymType s)
       : DocNode(parser,parent), m_symbol(s) {}
     HtmlEntityMapper::SymType symbol() const     { return m_symbol; }
@@ -319,8 +343,10 @@ class DocSymbol : public DocNode
 /** Node representing an emoji */
 class DocEmoji : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
     DocEmoji(DocParser *parser,DocNodeVariant *parent,const QCString &symName);
+    DocEmoji(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     QCString name() const      { return m_symName; }
     int index() const          { return m_index; }
 
@@ -332,7 +358,9 @@ class DocEmoji : public DocNode
 /** Node representing some amount of white space */
 class DocWhiteSpace : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocWhiteSpace(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     DocWhiteSpace(DocParser *parser,DocNodeVariant *parent,const QCString &chars)
       : DocNode(parser,parent), m_chars(chars) {}
     QCString chars() const     { return m_chars; }
@@ -343,7 +371,9 @@ class DocWhiteSpace : public DocNode
 /** Node representing a separator */
 class DocSeparator : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocSeparator(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     DocSeparator(DocParser *parser,DocNodeVariant *parent,const QCString &chars)
       : DocNode(parser,parent), m_chars(chars) {}
     QCString chars() const     { return m_chars; }
@@ -354,11 +384,14 @@ class DocSeparator : public DocNode
 /** Node representing a verbatim, unparsed text fragment */
 class DocVerbatim : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
     enum Type { Code, HtmlOnly, ManOnly, LatexOnly, RtfOnly, XmlOnly, Verbatim, Dot, Msc, DocbookOnly, PlantUML, JavaDocCode, JavaDocLiteral };
     DocVerbatim(DocParser *parser,DocNodeVariant *parent,const QCString &context,
                 const QCString &text, Type t,bool isExample,
                 const QCString &exampleFile,bool isBlock=FALSE,const QCString &lang=QCString());
+    DocVerbatim(DocNodeVariant *parent,DocNodeRestoreTag)
+      : DocNode(nullptr,parent), p(std::make_unique<Private>(QCString(),QCString(),Code,false,QCString(),QCString(),QCString(),false)) {}
     Type type() const            { return p->type; }
     QCString text() const        { return p->text; }
     QCString context() const     { return p->context; }
@@ -413,11 +446,13 @@ class DocVerbatim : public DocNode
 /** Node representing an included text block from file */
 class DocInclude : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
   enum Type { Include, DontInclude, VerbInclude, HtmlInclude, LatexInclude,
 	      IncWithLines, Snippet , SnippetWithLines,
 	      DontIncWithLines, RtfInclude, ManInclude, DocbookInclude, XmlInclude,
               SnippetTrimLeft};
+    DocInclude(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     DocInclude(DocParser *parser,DocNodeVariant *parent,const QCString &file,
                const QCString &context, Type t,
                bool isExample,const QCString &exampleFile,
@@ -450,8 +485,10 @@ class DocInclude : public DocNode
 /** Node representing a include/dontinclude operator block */
 class DocIncOperator : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
     enum Type { Line, SkipLine, Skip, Until };
+    DocIncOperator(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     DocIncOperator(DocParser *parser,DocNodeVariant *parent,Type t,const QCString &pat,
                    const QCString &context,bool isExample,const QCString &exampleFile)
     : DocNode(parser,parent), m_type(t), m_pattern(pat), m_context(context),
@@ -500,8 +537,10 @@ class DocIncOperator : public DocNode
 /** Node representing an item of a cross-referenced list */
 class DocFormula : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
     DocFormula(DocParser *parser,DocNodeVariant *parent,int id);
+    DocFormula(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     QCString name() const       { return m_name; }
     QCString text() const       { return m_text; }
     QCString relPath() const    { return m_relPath; }
@@ -523,7 +562,9 @@ class DocFormula : public DocNode
 /** Node representing an entry in the index. */
 class DocIndexEntry : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocIndexEntry(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     DocIndexEntry(DocParser *parser,DocNodeVariant *parent,const Definition *scope,const MemberDef *md)
       : DocNode(parser,parent), m_scope(scope), m_member(md) {}
     Token parse();
@@ -542,11 +583,13 @@ class DocIndexEntry : public DocNode
 /** Node representing an auto List */
 class DocAutoList : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
     enum ListType
     {
        Unnumbered=1, Unchecked=-2, Checked_x=-3, Checked_X=-4 // positive numbers give the label
     };
+    DocAutoList(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocAutoList(DocParser *parser,DocNodeVariant *parent,int indent,bool isEnumList,
                          int depth, bool isCheckedList);
 
@@ -566,7 +609,9 @@ class DocAutoList : public DocCompoundNode
 /** Node representing an item of a auto list */
 class DocAutoListItem : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocAutoListItem(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocAutoListItem(DocParser *parser,DocNodeVariant *parent,int indent,int num);
     int itemNumber() const     { return m_itemNum; }
     Token parse();
@@ -579,7 +624,9 @@ class DocAutoListItem : public DocCompoundNode
 /** Node representing a simple section title */
 class DocTitle : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocTitle(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocTitle(DocParser *parser,DocNodeVariant *parent) : DocCompoundNode(parser,parent) {}
     void parse();
     void parseFromString(DocNodeVariant *,const QCString &title);
@@ -591,8 +638,10 @@ class DocTitle : public DocCompoundNode
 /** Node representing an item of a cross-referenced list */
 class DocXRefItem : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
     DocXRefItem(DocParser *parser,DocNodeVariant *parent,int id,const QCString &key);
+    DocXRefItem(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     QCString file() const       { return m_file; }
     QCString anchor() const     { return m_anchor; }
     QCString title() const      { return m_title; }
@@ -612,10 +661,13 @@ class DocXRefItem : public DocCompoundNode
 /** Node representing an image */
 class DocImage : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
     enum Type { Html, Latex, Rtf, DocBook, Xml };
     DocImage(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs,
              const QCString &name,Type t,const QCString &url=QCString(), bool inlineImage = TRUE);
+    DocImage(DocNodeVariant *parent,DocNodeRestoreTag)
+      : DocCompoundNode(nullptr,parent), p(std::make_unique<Private>(HtmlAttribList(),QCString(),Html,QCString(),QCString(),true)) {}
     Type type() const           { return p->type; }
     QCString name() const       { return p->name; }
     bool hasCaption() const     { return !children().empty(); }
@@ -649,6 +701,7 @@ class DocImage : public DocCompoundNode
 
 class DocDiagramFileBase : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
     DocDiagramFileBase(DocParser *parser, DocNodeVariant *parent,const QCString &name,
                        const QCString &context, const QCString &srcFile,int srcLine)
@@ -683,43 +736,57 @@ class DocDiagramFileBase : public DocCompoundNode
 /** Node representing a dot file */
 class DocDotFile : public DocDiagramFileBase
 {
+    friend class DocNodeSerializer;
   public:
     DocDotFile(DocParser *parser,DocNodeVariant *parent,const QCString &name,const QCString &context,
                const QCString &srcFile,int srcLine);
+    DocDotFile(DocNodeVariant *parent,DocNodeRestoreTag)
+      : DocDiagramFileBase(nullptr,parent,QCString(),QCString(),QCString(),-1) {}
     bool parse();
 };
 
 /** Node representing a msc file */
 class DocMscFile : public DocDiagramFileBase
 {
+    friend class DocNodeSerializer;
   public:
     DocMscFile(DocParser *parser,DocNodeVariant *parent,const QCString &name,const QCString &context,
                const QCString &srcFile,int srcLine);
+    DocMscFile(DocNodeVariant *parent,DocNodeRestoreTag)
+      : DocDiagramFileBase(nullptr,parent,QCString(),QCString(),QCString(),-1) {}
     bool parse();
 };
 
 /** Node representing a dia file */
 class DocDiaFile : public DocDiagramFileBase
 {
+    friend class DocNodeSerializer;
   public:
     DocDiaFile(DocParser *parser,DocNodeVariant *parent,const QCString &name,const QCString &context,
                const QCString &srcFile,int srcLine);
+    DocDiaFile(DocNodeVariant *parent,DocNodeRestoreTag)
+      : DocDiagramFileBase(nullptr,parent,QCString(),QCString(),QCString(),-1) {}
     bool parse();
 };
 
 /** Node representing a uml file */
 class DocPlantUmlFile : public DocDiagramFileBase
 {
+    friend class DocNodeSerializer;
   public:
     DocPlantUmlFile(DocParser *parser,DocNodeVariant *parent,const QCString &name,const QCString &context,
                const QCString &srcFile,int srcLine);
+    DocPlantUmlFile(DocNodeVariant *parent,DocNodeRestoreTag)
+      : DocDiagramFileBase(nullptr,parent,QCString(),QCString(),QCString(),-1) {}
     bool parse();
 };
 
 /** Node representing a VHDL flow chart */
 class DocVhdlFlow : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocVhdlFlow(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocVhdlFlow(DocParser *parser,DocNodeVariant *parent);
     void parse();
     bool hasCaption() const { return !children().empty(); }
@@ -729,8 +796,10 @@ class DocVhdlFlow : public DocCompoundNode
 /** Node representing a link to some item */
 class DocLink : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
     DocLink(DocParser *parser,DocNodeVariant *parent,const QCString &target);
+    DocLink(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     QCString parse(bool,bool isXmlLink=FALSE);
     QCString file() const       { return m_file; }
     QCString relPath() const    { return m_relPath; }
@@ -748,8 +817,10 @@ class DocLink : public DocCompoundNode
 /** Node representing a reference to some item */
 class DocRef : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
     DocRef(DocParser *parser,DocNodeVariant *parent,const QCString &target,const QCString &context);
+    DocRef(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     void parse();
     QCString file() const         { return m_file; }
     QCString relPath() const      { return m_relPath; }
@@ -777,8 +848,10 @@ class DocRef : public DocCompoundNode
 /** Node representing an internal reference to some item */
 class DocInternalRef : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
     DocInternalRef(DocParser *parser,DocNodeVariant *parent,const QCString &target);
+    DocInternalRef(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     void parse();
     QCString file() const         { return m_file; }
     QCString relPath() const      { return m_relPath; }
@@ -793,7 +866,9 @@ class DocInternalRef : public DocCompoundNode
 /** Node representing a Hypertext reference */
 class DocHRef : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocHRef(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocHRef(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs,const QCString &url,
            const QCString &relPath, const QCString &file)
     : DocCompoundNode(parser,parent), m_attribs(attribs), m_url(url),
@@ -814,7 +889,9 @@ class DocHRef : public DocCompoundNode
 /** Node Html summary */
 class DocHtmlSummary : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocHtmlSummary(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocHtmlSummary(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs) :
        DocCompoundNode(parser,parent), m_attribs(attribs) {}
     const HtmlAttribList &attribs() const { return m_attribs; }
@@ -827,7 +904,9 @@ class DocHtmlSummary : public DocCompoundNode
 /** Node Html details */
 class DocHtmlDetails : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocHtmlDetails(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocHtmlDetails(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs) :
        DocCompoundNode(parser,parent), m_attribs(attribs) {}
     const HtmlAttribList &attribs() const { return m_attribs; }
@@ -843,7 +922,9 @@ class DocHtmlDetails : public DocCompoundNode
 /** Node Html heading */
 class DocHtmlHeader : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocHtmlHeader(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocHtmlHeader(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs,int level) :
        DocCompoundNode(parser,parent), m_level(level), m_attribs(attribs) {}
     int level() const                     { return m_level; }
@@ -858,7 +939,9 @@ class DocHtmlHeader : public DocCompoundNode
 /** Node representing a Html description item */
 class DocHtmlDescTitle : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocHtmlDescTitle(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocHtmlDescTitle(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs) :
       DocCompoundNode(parser,parent), m_attribs(attribs) {}
     const HtmlAttribList &attribs() const { return m_attribs; }
@@ -871,7 +954,9 @@ class DocHtmlDescTitle : public DocCompoundNode
 /** Node representing a Html description list */
 class DocHtmlDescList : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocHtmlDescList(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocHtmlDescList(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs) :
       DocCompoundNode(parser,parent), m_attribs(attribs) {}
     const HtmlAttribList &attribs() const { return m_attribs; }
@@ -884,7 +969,9 @@ class DocHtmlDescList : public DocCompoundNode
 /** Node representing a normal section */
 class DocSection : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocSection(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocSection(DocParser *parser,DocNodeVariant *parent,int level,const QCString &id) :
       DocCompoundNode(parser,parent), m_level(level), m_id(id) {}
     int level() const           { return m_level; }
@@ -905,8 +992,10 @@ class DocSection : public DocCompoundNode
 /** Node representing a reference to a section */
 class DocSecRefItem : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
     DocSecRefItem(DocParser *parser,DocNodeVariant *parent,const QCString &target);
+    DocSecRefItem(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     QCString target() const      { return m_target; }
     QCString file() const        { return m_file; }
     QCString anchor() const      { return m_anchor; }
@@ -929,7 +1018,9 @@ class DocSecRefItem : public DocCompoundNode
 /** Node representing a list of section references */
 class DocSecRefList : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocSecRefList(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocSecRefList(DocParser *parser,DocNodeVariant *parent) : DocCompoundNode(parser,parent) {}
     void parse();
 
@@ -939,7 +1030,9 @@ class DocSecRefList : public DocCompoundNode
 /** Node representing an internal section of documentation */
 class DocInternal : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocInternal(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocInternal(DocParser *parser,DocNodeVariant *parent) : DocCompoundNode(parser,parent) {}
     Token parse(int);
 
@@ -949,7 +1042,9 @@ class DocInternal : public DocCompoundNode
 /** Node representing an block of paragraphs */
 class DocParBlock : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocParBlock(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocParBlock(DocParser *parser,DocNodeVariant *parent) : DocCompoundNode(parser,parent) {}
     Token parse();
 
@@ -960,7 +1055,9 @@ class DocParBlock : public DocCompoundNode
 /** Node representing a simple list */
 class DocSimpleList : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocSimpleList(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocSimpleList(DocParser *parser,DocNodeVariant *parent) : DocCompoundNode(parser,parent) {}
     Token parse();
 
@@ -970,8 +1067,10 @@ class DocSimpleList : public DocCompoundNode
 /** Node representing a Html list */
 class DocHtmlList : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
     enum Type { Unordered, Ordered };
+    DocHtmlList(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocHtmlList(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs,Type t) :
       DocCompoundNode(parser,parent), m_type(t), m_attribs(attribs) {}
     Type type() const          { return m_type; }
@@ -987,6 +1086,7 @@ class DocHtmlList : public DocCompoundNode
 /** Node representing a simple section */
 class DocSimpleSect : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
     enum Type
     {
@@ -994,6 +1094,7 @@ class DocSimpleSect : public DocCompoundNode
        Note, Warning, Copyright, Pre, Post, Invar, Remark, Attention, Important,
        User, Rcs
     };
+    DocSimpleSect(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocSimpleSect(DocParser *parser,DocNodeVariant *parent,Type t);
     Type type() const       { return m_type; }
     QCString typeString() const;
@@ -1014,7 +1115,9 @@ class DocSimpleSect : public DocCompoundNode
  */
 class DocSimpleSectSep : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocSimpleSectSep(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     DocSimpleSectSep(DocParser *parser,DocNodeVariant *parent) : DocNode(parser,parent) {}
 
   private:
@@ -1023,6 +1126,7 @@ class DocSimpleSectSep : public DocNode
 /** Node representing a parameter section */
 class DocParamSect : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
     friend class DocParamList;
   public:
     enum Type
@@ -1033,6 +1137,7 @@ class DocParamSect : public DocCompoundNode
     {
        In=1, Out=2, InOut=3, Unspecified=0
     };
+    DocParamSect(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocParamSect(DocParser *parser,DocNodeVariant *parent,Type t)
       : DocCompoundNode(parser,parent), m_type(t), m_hasInOutSpecifier(FALSE), m_hasTypeSpecifier(FALSE)
     {}
@@ -1050,7 +1155,9 @@ class DocParamSect : public DocCompoundNode
 /** Node representing a paragraph in the documentation tree */
 class DocPara : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocPara(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocPara(DocParser *parser,DocNodeVariant *parent);
     Token parse();
     bool isEmpty() const        { return children().empty(); }
@@ -1095,7 +1202,9 @@ class DocPara : public DocCompoundNode
 /** Node representing a parameter list. */
 class DocParamList : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocParamList(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     DocParamList(DocParser *parser,DocNodeVariant *parent,DocParamSect::Type t,DocParamSect::Direction d)
       : DocNode(parser,parent), m_type(t), m_dir(d) {}
     const DocNodeList &parameters() const { return m_params; }
@@ -1123,7 +1232,9 @@ class DocParamList : public DocNode
 /** Node representing a simple list item */
 class DocSimpleListItem : public DocNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocSimpleListItem(DocNodeVariant *parent,DocNodeRestoreTag) : DocNode(nullptr,parent) {}
     DocSimpleListItem(DocParser *parser,DocNodeVariant *parent);
     Token parse();
     const DocNodeVariant *paragraph() const { return m_paragraph.get(); }
@@ -1135,7 +1246,9 @@ class DocSimpleListItem : public DocNode
 /** Node representing a HTML list item */
 class DocHtmlListItem : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocHtmlListItem(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocHtmlListItem(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs,int num)
     : DocCompoundNode(parser,parent), m_attribs(attribs), m_itemNum(num) {}
     int itemNumber() const                { return m_itemNum; }
@@ -1151,7 +1264,9 @@ class DocHtmlListItem : public DocCompoundNode
 /** Node representing a HTML description data */
 class DocHtmlDescData : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocHtmlDescData(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocHtmlDescData(DocParser *parser,DocNodeVariant *parent) : DocCompoundNode(parser,parent) {}
     const HtmlAttribList &attribs() const { return m_attribs; }
     Token parse();
@@ -1163,10 +1278,12 @@ class DocHtmlDescData : public DocCompoundNode
 /** Node representing a HTML table cell */
 class DocHtmlCell : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
     friend class DocHtmlTable;
   public:
     enum Alignment { Left, Right, Center };
     enum Valignment {Top, Middle, Bottom};
+    DocHtmlCell(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocHtmlCell(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs,bool isHeading) :
        DocCompoundNode(parser,parent), m_isHeading(isHeading), m_attribs(attribs) {}
     bool isHeading() const      { return m_isHeading; }
@@ -1198,7 +1315,9 @@ class DocHtmlCell : public DocCompoundNode
 /** Node representing a HTML table caption */
 class DocHtmlCaption : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocHtmlCaption(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocHtmlCaption(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs);
     const HtmlAttribList &attribs() const { return m_attribs; }
     Token parse();
@@ -1216,8 +1335,10 @@ class DocHtmlCaption : public DocCompoundNode
 /** Node representing a HTML table row */
 class DocHtmlRow : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
     friend class DocHtmlTable;
   public:
+    DocHtmlRow(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocHtmlRow(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs)
       : DocCompoundNode(parser,parent), m_attribs(attribs) {}
     size_t numCells() const      { return children().size(); }
@@ -1239,7 +1360,9 @@ class DocHtmlRow : public DocCompoundNode
 /** Node representing a HTML table */
 class DocHtmlTable : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocHtmlTable(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocHtmlTable(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs)
       : DocCompoundNode(parser,parent), m_attribs(attribs) {}
     size_t numRows() const  { return children().size(); }
@@ -1261,7 +1384,9 @@ class DocHtmlTable : public DocCompoundNode
 /** Node representing an HTML blockquote */
 class DocHtmlBlockQuote : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocHtmlBlockQuote(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocHtmlBlockQuote(DocParser *parser,DocNodeVariant *parent,const HtmlAttribList &attribs)
       : DocCompoundNode(parser,parent), m_attribs(attribs) {}
     Token parse();
@@ -1274,7 +1399,9 @@ class DocHtmlBlockQuote : public DocCompoundNode
 /** Root node of a text fragment */
 class DocText : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocText(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocText(DocParser *parser) : DocCompoundNode(parser,nullptr) {}
     void parse();
     bool isEmpty() const    { return children().empty(); }
@@ -1283,7 +1410,9 @@ class DocText : public DocCompoundNode
 /** Root node of documentation tree */
 class DocRoot : public DocCompoundNode
 {
+    friend class DocNodeSerializer;
   public:
+    DocRoot(DocNodeVariant *parent,DocNodeRestoreTag) : DocCompoundNode(nullptr,parent) {}
     DocRoot(DocParser *parser,bool indent,bool sl)
       : DocCompoundNode(parser,nullptr), m_indent(indent), m_singleLine(sl) {}
     void parse();
@@ -1436,6 +1565,7 @@ inline void dumpDocNodeList(const DocNodeList &children)
 /** Class representing the abstract syntax tree of a documentation block */
 class DocNodeAST : public IDocNodeAST
 {
+    friend class DocNodeSerializer;
   public:
     // Note that r can only be a rvalue, not a general forwarding reference.
     // The compiler will error on lvalues because DotNodeVariant doesn't have a copy constructor
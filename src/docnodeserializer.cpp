@@ -0,0 +1,448 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <array>
+#include <type_traits>
+#include <utility>
+
+#include "docnodeserializer.h"
+#include "memberdef.h"
+#include "serialization.h"
+
+// bump this whenever a node gets new fields or the order of the node types changes
+static const uint32_t g_formatVersion = 1;
+
+// marker stored for the scope and member of an index entry
+enum class DefRef { None, Context, Member };
+
+//---------------------------------------------------------------------------------------------
+
+/** Archive storing the values passed to it in a Serializer */
+class DocNodeSerializer::Writer
+{
+  public:
+    Writer(Serializer &s,const Definition *ctx,const MemberDef *md) : m_s(s), m_ctx(ctx), m_md(md) {}
+
+    void operator()(bool v)                { m_s.writeBool(v); }
+    void operator()(int v)                 { m_s.writeInt(v); }
+    void operator()(uint32_t v)            { m_s.writeUInt(v); }
+    void operator()(size_t v)              { m_s.writeSize(v); }
+    void operator()(const QCString &v)     { m_s.writeString(v); }
+    void operator()(const SectionType &v)  { m_s.writeInt(v.level()); }
+    template<class E,std::enable_if_t<std::is_enum<E>::value,int> = 0>
+    void operator()(E v)                   { m_s.writeEnum(v); }
+    void operator()(const HtmlAttribList &attribs)
+    {
+      m_s.writeSize(attribs.size());
+      for (const auto &attr : attribs)
+      {
+        m_s.writeString(attr.name);
+        m_s.writeString(attr.value);
+      }
+    }
+    void operator()(const DocNodeList &children)
+    {
+      m_s.writeSize(children.size());
+      for (const auto &child : children)
+      {
+        writeNode(*this,child);
+      }
+    }
+    void operator()(const std::unique_ptr<DocNodeVariant> &node)
+    {
+      m_s.writeBool(node!=nullptr);
+      if (node) writeNode(*this,*node);
+    }
+    void operator()(const Definition *d)
+    {
+      if      (d==nullptr) m_s.writeEnum(DefRef::None);
+      else if (d==m_ctx)   m_s.writeEnum(DefRef::Context);
+      else if (d==m_md)    m_s.writeEnum(DefRef::Member);
+      else                 fail();
+    }
+    void operator()(const MemberDef *md)
+    {
+      if      (md==nullptr) m_s.writeEnum(DefRef::None);
+      else if (md==m_md)    m_s.writeEnum(DefRef::Member);
+      else                  fail();
+    }
+    template<class T1,class T2,class... Ts>
+    void operator()(const T1 &v1,const T2 &v2,const Ts&... vs)
+    {
+      (*this)(v1);
+      (*this)(v2,vs...);
+    }
+
+    void writeIndex(size_t index) { m_s.writeSize(index); }
+    void fail()                   { m_ok=false; }
+    bool ok() const               { return m_ok; }
+
+  private:
+    Serializer &m_s;
+    const Definition *m_ctx;
+    const MemberDef *m_md;
+    bool m_ok = true;
+};
+
+//---------------------------------------------------------------------------------------------
+
+template<size_t I>
+static DocNodeVariant createNode(DocNodeVariant *parent)
+{
+  return DocNodeVariant(std::variant_alternative_t<I,DocNodeVariant>(parent,DocNodeRestoreTag()));
+}
+
+using CreateFunc = DocNodeVariant (*)(DocNodeVariant *);
+
+template<size_t... Is>
+static constexpr std::array<CreateFunc,sizeof...(Is)> makeCreateTable(std::index_sequence<Is...>)
+{
+  return { &createNode<Is>... };
+}
+
+// function to create an empty node for each alternative of DocNodeVariant, indexed by DocNodeVariant::index()
+static constexpr auto g_createNode = makeCreateTable(std::make_index_sequence<std::variant_size_v<DocNodeVariant>>());
+
+/** Archive reading values from a Deserializer into the fields passed to it */
+class DocNodeSerializer::Reader
+{
+  public:
+    Reader(Deserializer &d,const Definition *ctx,const MemberDef *md,DocNodeVariant *parent)
+      : m_d(d), m_ctx(ctx), m_md(md), m_parent(parent) {}
+    Reader(const Reader &r,DocNodeVariant *parent)
+      : m_d(r.m_d), m_ctx(r.m_ctx), m_md(r.m_md), m_parent(parent) {}
+
+    void operator()(bool &v)               { v = m_d.readBool(); }
+    void operator()(int &v)                { v = m_d.readInt(); }
+    void operator()(uint32_t &v)           { v = m_d.readUInt(); }
+    void operator()(size_t &v)             { v = m_d.readSize(); }
+    void operator()(QCString &v)           { v = m_d.readQCString(); }
+    void operator()(SectionType &v)        { v = SectionType(m_d.readInt()); }
+    template<class E,std::enable_if_t<std::is_enum<E>::value,int> = 0>
+    void operator()(E &v)                  { v = m_d.readEnum<E>(); }
+    void operator()(HtmlAttribList &attribs)
+    {
+      size_t n = m_d.readSize();
+      for (size_t i=0; i<n && !m_d.failed(); i++)
+      {
+        HtmlAttrib attr;
+        attr.name  = m_d.readQCString();
+        attr.value = m_d.readQCString();
+        attribs.push_back(attr);
+      }
+    }
+    void operator()(DocNodeList &children)
+    {
+      size_t n = m_d.readSize();
+      for (size_t i=0; i<n && !m_d.failed(); i++)
+      {
+        children.push_back(create());
+        readNode(*this,children.back());
+      }
+    }
+    void operator()(std::unique_ptr<DocNodeVariant> &node)
+    {
+      if (m_d.readBool())
+      {
+        node = std::make_unique<DocNodeVariant>(create());
+        readNode(*this,*node);
+      }
+    }
+    void operator()(const Definition *&d)
+    {
+      switch (m_d.readEnum<DefRef>())
+      {
+        case DefRef::None:    d = nullptr; break;
+        case DefRef::Context: d = m_ctx;   break;
+        case DefRef::Member:  d = m_md;    break;
+      }
+    }
+    void operator()(const MemberDef *&md)
+    {
+      md = m_d.readEnum<DefRef>()==DefRef::Member ? m_md : nullptr;
+    }
+    template<class T1,class T2,class... Ts>
+    void operator()(T1 &v1,T2 &v2,Ts&... vs)
+    {
+      (*this)(v1);
+      (*this)(v2,vs...);
+    }
+
+    /** Reads the type of the next node and returns an empty node of that type, whose parent is the current node. */
+    DocNodeVariant create()
+    {
+      size_t index = m_d.readSize();
+      if (index>=g_createNode.size())
+      {
+        m_d.setFailed();
+        index = 0;
+      }
+      return g_createNode[index](m_parent);
+    }
+    bool failed() const { return m_d.failed(); }
+
+  private:
+    Deserializer &m_d;
+    const Definition *m_ctx;
+    const MemberDef *m_md;
+    DocNodeVariant *m_parent;
+};
+
+//---------------------------------------------------------------------------------------------
+
+// The fields of each node type, in the order in which they are stored.
+// The children of compound nodes are handled by writeNode() and readNode().
+template<class Archive,class T>
+void DocNodeSerializer::fields(Archive &ar,T &n)
+{
+  if constexpr (std::is_same_v<T,DocWord>)
+  {
+    ar(n.m_word);
+  }
+  else if constexpr (std::is_same_v<T,DocLinkedWord>)
+  {
+    ar(n.m_word,n.m_ref,n.m_file,n.m_relPath,n.m_anchor,n.m_tooltip);
+  }
+  else if constexpr (std::is_same_v<T,DocURL>)
+  {
+    ar(n.m_url,n.m_isEmail);
+  }
+  else if constexpr (std::is_same_v<T,DocLineBreak> || std::is_same_v<T,DocHorRuler> ||
+                     std::is_same_v<T,DocHtmlSummary> || std::is_same_v<T,DocHtmlDescTitle> ||
+                     std::is_same_v<T,DocHtmlDescList> || std::is_same_v<T,DocHtmlDescData> ||
+                     std::is_same_v<T,DocHtmlBlockQuote>)
+  {
+    ar(n.m_attribs);
+  }
+  else if constexpr (std::is_same_v<T,DocAnchor>)
+  {
+    ar(n.m_anchor,n.m_file,n.m_attribs);
+  }
+  else if constexpr (std::is_same_v<T,DocCite>)
+  {
+    ar(n.m_file,n.m_relPath,n.m_ref,n.m_anchor,n.m_text);
+  }
+  else if constexpr (std::is_same_v<T,DocStyleChange>)
+  {
+    ar(n.m_position,n.m_style,n.m_enable,n.m_attribs,n.m_tagName);
+  }
+  else if constexpr (std::is_same_v<T,DocSymbol>)
+  {
+    ar(n.m_symbol);
+  }
+  else if constexpr (std::is_same_v<T,DocEmoji>)
+  {
+    ar(n.m_symName,n.m_index);
+  }
+  else if constexpr (std::is_same_v<T,DocWhiteSpace> || std::is_same_v<T,DocSeparator>)
+  {
+    ar(n.m_chars);
+  }
+  else if constexpr (std::is_same_v<T,DocVerbatim>)
+  {
+    ar(n.p->context,n.p->text,n.p->type,n.p->isExample,n.p->exampleFile,n.p->relPath,n.p->lang,
+       n.p->isBlock,n.p->width,n.p->height,n.p->engine,n.p->useBitmap,n.p->srcFile,n.p->srcLine);
+  }
+  else if constexpr (std::is_same_v<T,DocInclude>)
+  {
+    ar(n.m_file,n.m_context,n.m_text,n.m_type,n.m_isExample,n.m_isBlock,n.m_exampleFile,n.m_blockId);
+  }
+  else if constexpr (std::is_same_v<T,DocIncOperator>)
+  {
+    ar(n.m_type,n.m_line,n.m_showLineNo,n.m_text,n.m_pattern,n.m_context,n.m_isFirst,n.m_isLast,
+       n.m_isExample,n.m_exampleFile,n.m_includeFileName);
+  }
+  else if constexpr (std::is_same_v<T,DocFormula>)
+  {
+    ar(n.m_name,n.m_text,n.m_relPath,n.m_id);
+  }
+  else if constexpr (std::is_same_v<T,DocIndexEntry>)
+  {
+    ar(n.m_entry,n.m_scope,n.m_member);
+  }
+  else if constexpr (std::is_same_v<T,DocAutoList>)
+  {
+    ar(n.m_indent,n.m_isEnumList,n.m_isCheckedList,n.m_depth);
+  }
+  else if constexpr (std::is_same_v<T,DocAutoListItem>)
+  {
+    ar(n.m_indent,n.m_itemNum);
+  }
+  else if constexpr (std::is_same_v<T,DocXRefItem>)
+  {
+    ar(n.m_id,n.m_key,n.m_file,n.m_anchor,n.m_title,n.m_relPath);
+  }
+  else if constexpr (std::is_same_v<T,DocImage>)
+  {
+    ar(n.p->attribs,n.p->name,n.p->type,n.p->width,n.p->height,n.p->relPath,n.p->url,n.p->inlineImage);
+  }
+  else if constexpr (std::is_base_of_v<DocDiagramFileBase,T>)
+  {
+    ar(n.p->name,n.p->file,n.p->relPath,n.p->width,n.p->height,n.p->context,n.p->srcFile,n.p->srcLine);
+  }
+  else if constexpr (std::is_same_v<T,DocLink>)
+  {
+    ar(n.m_file,n.m_relPath,n.m_ref,n.m_anchor,n.m_refText);
+  }
+  else if constexpr (std::is_same_v<T,DocRef>)
+  {
+    ar(n.m_refType,n.m_sectionType,n.m_isSubPage,n.m_file,n.m_relPath,n.m_ref,n.m_anchor,n.m_text);
+  }
+  else if constexpr (std::is_same_v<T,DocInternalRef>)
+  {
+    ar(n.m_file,n.m_relPath,n.m_anchor);
+  }
+  else if constexpr (std::is_same_v<T,DocHRef>)
+  {
+    ar(n.m_attribs,n.m_url,n.m_relPath,n.m_file);
+  }
+  else if constexpr (std::is_same_v<T,DocHtmlDetails>)
+  {
+    ar(n.m_attribs,n.m_summary);
+  }
+  else if constexpr (std::is_same_v<T,DocHtmlHeader>)
+  {
+    ar(n.m_level,n.m_attribs);
+  }
+  else if constexpr (std::is_same_v<T,DocSection>)
+  {
+    ar(n.m_level,n.m_id,n.m_title,n.m_anchor,n.m_file);
+  }
+  else if constexpr (std::is_same_v<T,DocSecRefItem>)
+  {
+    ar(n.m_target,n.m_refType,n.m_isSubPage,n.m_file,n.m_relPath,n.m_ref,n.m_anchor);
+  }
+  else if constexpr (std::is_same_v<T,DocHtmlList>)
+  {
+    ar(n.m_type,n.m_attribs);
+  }
+  else if constexpr (std::is_same_v<T,DocSimpleSect>)
+  {
+    ar(n.m_type,n.m_title);
+  }
+  else if constexpr (std::is_same_v<T,DocParamSect>)
+  {
+    ar(n.m_type,n.m_hasInOutSpecifier,n.m_hasTypeSpecifier);
+  }
+  else if constexpr (std::is_same_v<T,DocPara>)
+  {
+    ar(n.m_isFirst,n.m_isLast,n.m_attribs);
+  }
+  else if constexpr (std::is_same_v<T,DocParamList>)
+  {
+    ar(n.m_paragraphs,n.m_params,n.m_paramTypes,n.m_type,n.m_dir,n.m_isFirst,n.m_isLast);
+  }
+  else if constexpr (std::is_same_v<T,DocSimpleListItem>)
+  {
+    ar(n.m_paragraph);
+  }
+  else if constexpr (std::is_same_v<T,DocHtmlListItem>)
+  {
+    ar(n.m_attribs,n.m_itemNum);
+  }
+  else if constexpr (std::is_same_v<T,DocHtmlCell>)
+  {
+    ar(n.m_isHeading,n.m_isFirst,n.m_isLast,n.m_attribs,n.m_rowIdx,n.m_colIdx);
+  }
+  else if constexpr (std::is_same_v<T,DocHtmlCaption>)
+  {
+    ar(n.m_attribs,n.m_hasCaptionId,n.m_file,n.m_anchor);
+  }
+  else if constexpr (std::is_same_v<T,DocHtmlRow>)
+  {
+    ar(n.m_attribs,n.m_visibleCells,n.m_rowIdx);
+  }
+  else if constexpr (std::is_same_v<T,DocHtmlTable>)
+  {
+    ar(n.m_caption,n.m_attribs,n.m_numCols);
+  }
+  else if constexpr (std::is_same_v<T,DocRoot>)
+  {
+    ar(n.m_indent,n.m_singleLine);
+  }
+  else // nodes without fields of their own
+  {
+    static_assert(std::is_same_v<T,DocTitle>      || std::is_same_v<T,DocVhdlFlow>      ||
+                  std::is_same_v<T,DocSecRefList> || std::is_same_v<T,DocInternal>      ||
+                  std::is_same_v<T,DocParBlock>   || std::is_same_v<T,DocSimpleList>    ||
+                  std::is_same_v<T,DocSimpleSectSep> || std::is_same_v<T,DocText>,
+                  "new node type without serialized fields");
+  }
+}
+
+void DocNodeSerializer::writeNode(Writer &w,const DocNodeVariant &v)
+{
+  // images are copied to the output directory while parsing, the others
+  // refer to global state (formulas, citations, cross reference lists)
+  if (holds_one_of_alternatives<DocImage,DocFormula,DocCite,DocXRefItem>(v))
+  {
+    w.fail();
+    return;
+  }
+  w.writeIndex(v.index());
+  std::visit([&w](const auto &cn)
+  {
+    using T = std::decay_t<decltype(cn)>;
+    T &n = const_cast<T&>(cn); // fields() is shared with the reader, the writer only reads
+    w(n.m_insidePre);
+    fields(w,n);
+    if constexpr (details::has_method_children<T>::value)
+    {
+      w(n.children());
+    }
+  },v);
+}
+
+void DocNodeSerializer::readNode(Reader &parentReader,DocNodeVariant &v)
+{
+  Reader r(parentReader,&v);
+  std::visit([&r,&v](auto &n)
+  {
+    using T = std::decay_t<decltype(n)>;
+    n.setThisVariant(&v);
+    r(n.m_insidePre);
+    fields(r,n);
+    if constexpr (details::has_method_children<T>::value)
+    {
+      r(n.children());
+    }
+  },v);
+}
+
+//---------------------------------------------------------------------------------------------
+
+uint32_t DocNodeSerializer::formatVersion()
+{
+  return g_formatVersion;
+}
+
+bool DocNodeSerializer::serialize(Serializer &s,const IDocNodeAST &ast,const Definition *ctx,const MemberDef *md)
+{
+  const DocNodeAST *astImpl = dynamic_cast<const DocNodeAST*>(&ast);
+  if (astImpl==nullptr) return false;
+  Writer w(s,ctx,md);
+  writeNode(w,astImpl->root);
+  return w.ok();
+}
+
+IDocNodeASTPtr DocNodeSerializer::deserialize(Deserializer &d,const Definition *ctx,const MemberDef *md)
+{
+  auto ast = std::make_unique<DocNodeAST>(DocRoot(nullptr,DocNodeRestoreTag()));
+  Reader r(d,ctx,md,nullptr);
+  ast->root = r.create();
+  readNode(r,ast->root);
+  if (r.failed() || !holds_one_of_alternatives<DocRoot,DocText>(ast->root)) return nullptr;
+  return ast;
+}
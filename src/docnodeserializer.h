@@ -0,0 +1,60 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef DOCNODESERIALIZER_H
+#define DOCNODESERIALIZER_H
+
+#include <cstdint>
+
+#include "docnode.h"
+
+class Serializer;
+class Deserializer;
+class Definition;
+class MemberDef;
+
+/** @brief Converts the abstract syntax tree of a documentation block to and from a compact binary form.
+ *
+ *  Only the state that the output generators need is stored, the parser that
+ *  created the nodes is not. A tree that refers to global state that cannot be
+ *  restored is refused by serialize(), such as images (which are copied to the
+ *  output directory while parsing), formulas, citations and cross reference
+ *  items. Index entries may only refer to the context or member the block was
+ *  parsed for, these are passed again to deserialize().
+ */
+class DocNodeSerializer
+{
+  public:
+    /** Returns the version of the binary layout, to be stored along with the data. */
+    static uint32_t formatVersion();
+
+    /** Writes \a ast, parsed in the context of \a ctx and \a md, to \a s.
+     *  Returns FALSE if the tree cannot be stored, the contents of \a s are undefined then.
+     */
+    static bool serialize(Serializer &s,const IDocNodeAST &ast,const Definition *ctx,const MemberDef *md);
+
+    /** Reads a tree written by serialize() from \a d, or returns nullptr if the data is invalid. */
+    static IDocNodeASTPtr deserialize(Deserializer &d,const Definition *ctx,const MemberDef *md);
+
+  private:
+    class Writer;
+    class Reader;
+    template<class Archive,class T>
+    static void fields(Archive &ar,T &n);
+    static void writeNode(Writer &w,const DocNodeVariant &v);
+    static void readNode(Reader &r,DocNodeVariant &v);
+};
+
+#endif
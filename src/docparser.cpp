@@ -16,6 +16,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <cassert>
+#include <cinttypes>
 
 #include <ctype.h>
 
@@ -38,6 +39,9 @@
 #include "util.h"
 #include "indexlist.h"
 #include "trace.h"
+#include "cache.h"
+#include "docaststore.h"
+#include "md5.h"
 
 #if !ENABLE_DOCPARSER_TRACING
 #undef  AUTO_TRACE
@@ -2097,6 +2101,111 @@ IDocNodeASTPtr validatingParseDoc(IDocParser &parserIntf,
   return ast;
 }
 
+//---------------------------------------------------------------------------
+
+// maximum number of ASTs kept by the DocAstCache
+static constexpr size_t g_docAstCacheSize = 16384;
+
+struct DocAstCache::Private
+{
+  std::atomic<bool> enabled = false;
+  ConcurrentCache< std::shared_ptr<const IDocNodeAST> > cache{g_docAstCacheSize};
+};
+
+DocAstCache::DocAstCache() : p(std::make_unique<Private>())
+{
+}
+
+DocAstCache::~DocAstCache() = default;
+
+DocAstCache &DocAstCache::instance()
+{
+  static DocAstCache cache;
+  return cache;
+}
+
+void DocAstCache::setEnabled(bool enabled)
+{
+  if (enabled && !p->enabled)
+  {
+    DocAstStore::instance().load();
+  }
+  else if (!enabled && p->enabled)
+  {
+    DocAstStore::instance().save();
+  }
+  p->enabled = enabled;
+  if (!enabled) p->cache.clear();
+}
+
+void DocAstCache::printStatistics() const
+{
+  msg("documentation AST cache used %zu/%zu hits=%" PRIu64 " misses=%" PRIu64 "\n",
+      p->cache.size(),p->cache.capacity(),p->cache.hits(),p->cache.misses());
+  DocAstStore::instance().printStatistics();
+}
+
+std::shared_ptr<const IDocNodeAST> DocAstCache::parse(const QCString &fileName,int startLine,
+                            const Definition *ctx,const MemberDef *md,
+                            const QCString &input,bool indexWords,
+                            bool isExample, const QCString &exampleName,
+                            bool singleLine, bool linkFromIndex,
+                            bool markdownSupport)
+{
+  auto parseDoc = [&]() -> std::shared_ptr<const IDocNodeAST>
+  {
+    auto parser { createDocParser() };
+    return validatingParseDoc(*parser.get(),fileName,startLine,ctx,md,input,indexWords,
+                              isExample,exampleName,singleLine,linkFromIndex,markdownSupport);
+  };
+  if (!p->enabled || (indexWords && Doxygen::searchIndex.enabled()))
+  {
+    return parseDoc();
+  }
+
+  // the key identifies the input by its MD5 hash and includes all other arguments
+  uint8_t md5_sig[16];
+  MD5Buffer(input.data(),static_cast<unsigned int>(input.length()),md5_sig);
+  std::string key(reinterpret_cast<const char *>(md5_sig),sizeof(md5_sig));
+  char args[128];
+  qsnprintf(args,sizeof(args),"%p:%p:%d:%d%d%d%d:",static_cast<const void*>(ctx),static_cast<const void*>(md),
+            startLine,isExample,singleLine,linkFromIndex,markdownSupport);
+  key+=args;
+  key+=fileName.str();
+  key+=':';
+  key+=exampleName.str();
+
+  if (auto ast = p->cache.find(key))
+  {
+    return *ast;
+  }
+
+  // not parsed before in this run, try the ASTs stored by an earlier run
+  std::shared_ptr<const IDocNodeAST> ast;
+  DocAstStore &store = DocAstStore::instance();
+  std::string storeKey = store.isEnabled() ?
+     DocAstStore::key(fileName,startLine,ctx,md,input,isExample,exampleName,singleLine,linkFromIndex,markdownSupport) :
+     std::string();
+  std::string fingerprint;
+  if (!storeKey.empty())
+  {
+    fingerprint = DocAstStore::fingerprint(input);
+    ast = store.find(storeKey,fingerprint,ctx,md);
+  }
+  if (!ast)
+  {
+    size_t warnCount = warnCountForCurrentThread();
+    ast = parseDoc();
+    // blocks producing warnings are parsed again, so the warnings are reported on every run
+    if (!storeKey.empty() && ast && warnCountForCurrentThread()==warnCount)
+    {
+      store.store(storeKey,fingerprint,*ast,ctx,md);
+    }
+  }
+  p->cache.insert(key,ast);
+  return ast;
+}
+
 IDocNodeASTPtr validatingParseText(IDocParser &parserIntf,const QCString &input)
 {
   DocParser *parser = dynamic_cast<DocParser*>(&parserIntf);
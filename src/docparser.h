@@ -85,6 +85,48 @@ IDocNodeASTPtr validatingParseDoc(IDocParser &parserIntf,const QCString &fileNam
                             bool singleLine,bool linkFromIndex,
                             bool markdownSupport);
 
+/*! @brief Cache of parsed documentation blocks, shared by all output formats.
+ *
+ *  The same block is often written several times, for instance a brief description
+ *  that appears on the page of a class, in the member overview, and in a tooltip.
+ *  When enabled, parse() returns the AST of an earlier call with the same input and
+ *  arguments instead of parsing the block again. Since the ASTs are shared between
+ *  threads they are immutable. The nodes only use their parser while parsing, so a
+ *  cached AST can outlive the parser that created it.
+ *
+ *  The cache should only be enabled once the symbol tables no longer change, since
+ *  links in the AST are resolved while parsing.
+ */
+class DocAstCache
+{
+  public:
+    static DocAstCache &instance();
+
+    /** Same as validatingParseDoc(), but returns the cached AST if the block was parsed before
+     *  with the same arguments. Blocks whose words are added to the search index are always
+     *  parsed, since the index is filled while parsing.
+     */
+    std::shared_ptr<const IDocNodeAST> parse(const QCString &fileName,int startLine,
+                                             const Definition *ctx, const MemberDef *md,
+                                             const QCString &input,bool indexWords,
+                                             bool isExample,const QCString &exampleName,
+                                             bool singleLine,bool linkFromIndex,
+                                             bool markdownSupport);
+
+    /** Enables or disables caching, disabling the cache also removes the cached ASTs. */
+    void setEnabled(bool enabled);
+
+    /** Prints the usage of the cache. */
+    void printStatistics() const;
+
+  private:
+    DocAstCache();
+   ~DocAstCache();
+    NON_COPYABLE(DocAstCache)
+    struct Private;
+    std::unique_ptr<Private> p;
+};
+
 /*! Main entry point for parsing simple text fragments. These
  *  fragments are limited to words, whitespace and symbols.
  */
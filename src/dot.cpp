@@ -21,6 +21,7 @@
 
 #include "config.h"
 #include "dot.h"
+#include "chrometrace.h"
 #include "dotrunner.h"
 #include "dotfilepatcher.h"
 #include "util.h"
@@ -81,7 +82,7 @@ DotManager *DotManager::instance()
   return &theInstance;
 }
 
-DotManager::DotManager() : m_runners(), m_filePatchers(), m_workers(static_cast<size_t>(Config_getInt(DOT_NUM_THREADS)))
+DotManager::DotManager() : m_runners(), m_filePatchers(), m_workers(static_cast<size_t>(Config_getInt(DOT_NUM_THREADS)),"dot",TaskPriority::Low)
 {
 }
 
@@ -182,13 +183,14 @@ bool DotManager::run()
       DotRunner *runner = dr.second.get();
       auto process = [runner]()
       {
+        ChromeTrace::Span span("dot",runner->getFileName());
         runner->run();
       };
       results.emplace_back(m_workers.queue(process));
     }
     for (auto &f : results)
     {
-      f.get();
+      m_workers.wait(f);
       msg("Running dot for graph %zu/%zu\n",prev,numDotRuns);
       prev++;
     }
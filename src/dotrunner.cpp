@@ -13,8 +13,10 @@
 *
 */
 
+#include <atomic>
 #include <cassert>
 #include <cmath>
+#include <mutex>
 
 #ifdef _MSC_VER
 #pragma warning( push )
@@ -42,6 +44,8 @@
 #include "config.h"
 #include "dir.h"
 #include "doxygen.h"
+#include "fileinfo.h"
+#include "md5.h"
 
 // the graphicx LaTeX has a limitation of maximum size of 16384
 // To be on the save side we take it a little bit smaller i.e. 150 inch * 72 dpi
@@ -271,6 +275,93 @@ void DotRunner::addJob(const QCString &format, const QCString &output,
   m_jobs.emplace_back(format, output, args, srcFile, srcLine);
 }
 
+// returns the version information printed by the dot tool, which is part of the DOT_CACHE_DIR keys
+static QCString dotVersion(const QCString &dotExe)
+{
+  static std::once_flag versionOnce;
+  static QCString version;
+  std::call_once(versionOnce,[&dotExe]()
+  {
+    FILE *f = Portable::popen("\""+dotExe+"\" -V 2>&1","r");
+    if (f)
+    {
+      char buf[256];
+      while (fgets(buf,sizeof(buf),f))
+      {
+        version+=buf;
+      }
+      Portable::pclose(f);
+    }
+  });
+  return version;
+}
+
+/** Returns the name of the file in DOT_CACHE_DIR holding the output of \a job,
+ *  or an empty string if no cache is used.
+ */
+QCString DotRunner::cacheFileName(const DotJob &job) const
+{
+  QCString cacheDir = Config_getString(DOT_CACHE_DIR);
+  if (cacheDir.isEmpty() || m_md5Hash.isEmpty()) return QCString();
+  QCString key = m_md5Hash+"\n"+job.format+"\n"+dotVersion(m_dotExe)+"\n"+Config_getString(DOT_FONTPATH);
+  uint8_t md5_sig[16];
+  char sigStr[33];
+  MD5Buffer(key.data(),static_cast<unsigned int>(key.length()),md5_sig);
+  MD5SigToString(md5_sig,sigStr);
+  return cacheDir+"/"+sigStr;
+}
+
+/** Puts the output of all jobs in place from DOT_CACHE_DIR.
+ *  Returns FALSE if the output of any of the jobs is not in the cache.
+ */
+bool DotRunner::restoreFromCache() const
+{
+  if (m_jobs.empty()) return FALSE;
+  StringVector cacheFiles;
+  for (const auto &s : m_jobs)
+  {
+    QCString cacheFile = cacheFileName(s);
+    if (cacheFile.isEmpty() || !FileInfo(cacheFile.str()).exists()) return FALSE;
+    cacheFiles.push_back(cacheFile.str());
+  }
+  Dir dir;
+  for (size_t i=0; i<m_jobs.size(); i++)
+  {
+    std::string output = m_jobs[i].output.str();
+    dir.remove(output);
+    if (!dir.link(cacheFiles[i],output) && !dir.copy(cacheFiles[i],output))
+    {
+      return FALSE; // let dot produce the output instead
+    }
+  }
+  return TRUE;
+}
+
+/** Adds the output of all jobs to DOT_CACHE_DIR. */
+void DotRunner::storeInCache() const
+{
+  static std::atomic<uint32_t> tmpCount = 0;
+  QCString cacheDir = Config_getString(DOT_CACHE_DIR);
+  if (cacheDir.isEmpty() || m_md5Hash.isEmpty()) return;
+  Dir dir;
+  if (!dir.mkdir(cacheDir.str())) return;
+  for (const auto &s : m_jobs)
+  {
+    QCString cacheFile = cacheFileName(s);
+    if (FileInfo(cacheFile.str()).exists()) continue;
+    // create the entry under a unique name first, so other runs never see an incomplete file
+    QCString tmpFile;
+    tmpFile.sprintf("%s.%u.%u.tmp",qPrint(cacheFile),Portable::pid(),tmpCount++);
+    if (dir.link(s.output.str(),tmpFile.str()) || dir.copy(s.output.str(),tmpFile.str()))
+    {
+      if (!dir.rename(tmpFile.str(),cacheFile.str()))
+      {
+        dir.remove(tmpFile.str());
+      }
+    }
+  }
+}
+
 QCString getBaseNameOfOutput(const QCString &output)
 {
   int index = output.findRev('.');
@@ -287,6 +378,19 @@ bool DotRunner::run()
   QCString srcFile;
   int srcLine=-1;
 
+  if (restoreFromCache()) // produced before, possibly for another output directory
+  {
+    finish();
+    return TRUE;
+  }
+
+  // an existing output file may be a hard link into DOT_CACHE_DIR, so remove it
+  // instead of letting dot overwrite its contents
+  for (auto& s : m_jobs)
+  {
+    Dir().remove(s.output.str());
+  }
+
   // create output
   if (Config_getBool(DOT_MULTI_TARGETS))
   {
@@ -336,6 +440,17 @@ bool DotRunner::run()
     }
   }
 
+  storeInCache();
+  finish();
+  return TRUE;
+error:
+  err_full(srcFile,srcLine,"Problems running dot: exit code=%d, command='%s', arguments='%s'",
+    exitCode,qPrint(m_dotExe),qPrint(dotArgs));
+  return FALSE;
+}
+
+void DotRunner::finish()
+{
   // remove .dot files
   if (m_cleanUp)
   {
@@ -354,11 +469,6 @@ bool DotRunner::run()
       fclose(f);
     }
   }
-  return TRUE;
-error:
-  err_full(srcFile,srcLine,"Problems running dot: exit code=%d, command='%s', arguments='%s'",
-    exitCode,qPrint(m_dotExe),qPrint(dotArgs));
-  return FALSE;
 }
 
 
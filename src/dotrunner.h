@@ -57,10 +57,16 @@ class DotRunner
     bool run();
 
     QCString getMd5Hash() { return m_md5Hash; }
+    QCString getFileName() const { return m_file; }
 
     static bool readBoundingBox(const QCString &fileName, int* width, int* height, bool isEps);
 
   private:
+    QCString cacheFileName(const DotJob &job) const;
+    bool restoreFromCache() const;
+    void storeInCache() const;
+    void finish();
+
     QCString m_file;
     QCString m_md5Hash;
     QCString m_dotExe;
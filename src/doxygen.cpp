@@ -25,6 +25,9 @@
 #include <chrono>
 #include <clocale>
 #include <locale>
+#include <future>
+#include <thread>
+#include <mutex>
 
 #include "version.h"
 #include "doxygen.h"
@@ -109,6 +112,12 @@
 #include "trace.h"
 #include "moduledef.h"
 #include "stringutil.h"
+#include "parsecache.h"
+#include "phasescheduler.h"
+#include "chrometrace.h"
+#include "costmodel.h"
+#include "lookupcachestore.h"
+#include "streampipe.h"
 
 #include <sqlite3.h>
 
@@ -155,17 +164,27 @@ bool                  Doxygen::parseSourcesNeeded = FALSE;
 SearchIndexIntf       Doxygen::searchIndex;
 SymbolMap<Definition>*Doxygen::symbolMap;
 ClangUsrMap          *Doxygen::clangUsrMap = nullptr;
-Cache<std::string,LookupInfo> *Doxygen::typeLookupCache;
-Cache<std::string,LookupInfo> *Doxygen::symbolLookupCache;
+ConcurrentCache<LookupInfo> *Doxygen::typeLookupCache;
+ConcurrentCache<LookupInfo> *Doxygen::symbolLookupCache;
 DirLinkedMap         *Doxygen::dirLinkedMap;
 DirRelationLinkedMap  Doxygen::dirRelations;
 ParserManager        *Doxygen::parserManager = nullptr;
 QCString              Doxygen::htmlFileExtension;
-bool                  Doxygen::suppressDocWarnings = FALSE;
+thread_local bool     Doxygen::suppressDocWarnings = FALSE;
 QCString              Doxygen::filterDBFileName;
 IndexList            *Doxygen::indexList;
 QCString              Doxygen::spaces;
-bool                  Doxygen::generatingXmlOutput = FALSE;
+thread_local bool     Doxygen::generatingXmlOutput = FALSE;
+static ThreadStateRegistration g_generatorThreadState([]()
+{
+  bool xml = Doxygen::generatingXmlOutput;
+  bool suppress = Doxygen::suppressDocWarnings;
+  return std::function<void()>([xml,suppress]()
+  {
+    Doxygen::generatingXmlOutput = xml;
+    Doxygen::suppressDocWarnings = suppress;
+  });
+});
 DefinesPerFileList    Doxygen::macroDefinitions;
 bool                  Doxygen::clangAssistedParsing = FALSE;
 QCString              Doxygen::verifiedDotPath;
@@ -181,6 +200,8 @@ static OutputList      *g_outputList = nullptr;          // list of output gener
 static StringSet        g_usingDeclarations; // used classes
 static bool             g_successfulRun = FALSE;
 static bool             g_dumpSymbolMap = FALSE;
+static std::future<void> g_entryTreeReleased;       // set while the Entry tree is freed in the background
+static const size_t     g_pipeCapacity = 64*1024; // max. bytes in transit between preprocessor and comment converter
 
 // keywords recognised as compounds
 static const StringUnorderedSet g_compoundKeywords =
@@ -222,12 +243,25 @@ class Statistics
       msg("%s", name);
       stats.emplace_back(name,0);
       startTime = std::chrono::steady_clock::now();
+      stats.back().typeCache.start(Doxygen::typeLookupCache);
+      stats.back().symbolCache.start(Doxygen::symbolLookupCache);
     }
     void end()
     {
       std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
       stats.back().elapsed = static_cast<double>(std::chrono::duration_cast<
                                 std::chrono::microseconds>(endTime - startTime).count())/1000000.0;
+      stats.back().typeCache.stop(Doxygen::typeLookupCache);
+      stats.back().symbolCache.stop(Doxygen::symbolLookupCache);
+      ChromeTrace::instance().addSpan("phase",QCString(stats.back().name).stripWhiteSpace(),startTime,endTime);
+      warn_flush();
+    }
+    void add(const PhaseScheduler &scheduler)
+    {
+      for (const auto &t : scheduler.timings())
+      {
+        stats.emplace_back(t.name,t.elapsed);
+      }
       warn_flush();
     }
     void print()
@@ -245,11 +279,44 @@ class Statistics
       }
       if (restore) Debug::setFlag(Debug::Time);
     }
+    void printLookupCaches()
+    {
+      msg("Lookup cache usage per step (type cache, symbol cache):\n");
+      for (const auto &s : stats)
+      {
+        if (s.typeCache.lookups()>0 || s.symbolCache.lookups()>0)
+        {
+          msg("  %s    size %zu, %" PRIu64 " lookups, %.1f%% hits; size %zu, %" PRIu64 " lookups, %.1f%% hits\n",
+              QCString(s.name).stripWhiteSpace().data(),
+              s.typeCache.capacity,s.typeCache.lookups(),s.typeCache.hitRate(),
+              s.symbolCache.capacity,s.symbolCache.lookups(),s.symbolCache.hitRate());
+        }
+      }
+    }
   private:
+    // lookup cache usage during a single step
+    struct CacheUsage
+    {
+      size_t capacity = 0;
+      uint64_t hits = 0;
+      uint64_t misses = 0;
+      void start(const ConcurrentCache<LookupInfo> *cache)
+      {
+        if (cache) { hits=cache->hits(); misses=cache->misses(); }
+      }
+      void stop(const ConcurrentCache<LookupInfo> *cache)
+      {
+        if (cache) { capacity=cache->capacity(); hits=cache->hits()-hits; misses=cache->misses()-misses; }
+      }
+      uint64_t lookups() const { return hits+misses; }
+      double hitRate() const { return lookups()>0 ? 100.0*static_cast<double>(hits)/static_cast<double>(lookups()) : 0.0; }
+    };
     struct stat
     {
       const char *name;
       double elapsed;
+      CacheUsage typeCache;
+      CacheUsage symbolCache;
       //stat() : name(nullptr),elapsed(0) {}
       stat(const char *n, double el) : name(n),elapsed(el) {}
     };
@@ -8357,6 +8424,24 @@ static void buildCompleteMemberLists()
 
 //----------------------------------------------------------------------------
 
+//! returns the indices 0..n-1 ordered by decreasing cost, so the most expensive
+//! jobs can be queued first. Jobs with the same cost keep their original order.
+template<class Func>
+static std::vector<size_t> costOrder(size_t n,Func cost)
+{
+  std::vector<double> costs(n);
+  std::vector<size_t> order(n);
+  for (size_t i=0; i<n; i++)
+  {
+    costs[i] = cost(i);
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(),order.end(),[&costs](size_t a,size_t b) { return costs[a]>costs[b]; });
+  return order;
+}
+
+//----------------------------------------------------------------------------
+
 static void generateFileSources()
 {
   auto processSourceFile = [](FileDef *fd,OutputList &ol,ClangTUParser *parser)
@@ -8379,7 +8464,129 @@ static void generateFileSources()
   if (!Doxygen::inputNameLinkedMap->empty())
   {
 #if USE_LIBCLANG
-    if (Doxygen::clangAssistedParsing)
+    std::size_t numClangThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
+    if (Doxygen::clangAssistedParsing && numClangThreads>1)
+    {
+      msg("Generating code files using %zu threads.\n",numClangThreads);
+      struct SourceContext
+      {
+        SourceContext(FileDef *fd_,const OutputList &ol_)
+          : fd(fd_), ol(ol_) {}
+        FileDef *fd;
+        OutputList ol;
+      };
+      StringUnorderedSet claimedFiles; // files that are taken care of by a translation unit
+      StringUnorderedSet filesToProcess;
+      std::vector<FileDef*> tuFiles;
+      std::vector<size_t> tuSizes;
+      for (const auto &fn : *Doxygen::inputNameLinkedMap)
+      {
+        for (const auto &fd : *fn)
+        {
+          filesToProcess.insert(fd->absFilePath().str());
+          if (fd->isSource() && !fd->isReference() && fd->getLanguage()==SrcLangExt::Cpp &&
+              (fd->generateSourceFile() || Doxygen::parseSourcesNeeded))
+          {
+            // each source file is handled by its own translation unit, never as part of another one
+            claimedFiles.insert(fd->absFilePath().str());
+            tuFiles.push_back(fd.get());
+            tuSizes.push_back(FileInfo(fd->absFilePath().str()).size());
+          }
+        }
+      }
+      // assign each include file to the first translation unit (in input order) that includes it,
+      // before starting the threads, so the output does not depend on which unit finishes first
+      std::vector< std::vector<FileDef*> > tuIncludes(tuFiles.size());
+      for (size_t i=0; i<tuFiles.size(); i++)
+      {
+        StringVector incFiles;
+        tuFiles[i]->getAllIncludeFilesRecursively(incFiles);
+        for (const auto &incFile : incFiles)
+        {
+          if (filesToProcess.find(incFile)!=filesToProcess.end() &&  // part of input
+              claimedFiles.find(incFile)==claimedFiles.end())        // not a source file or included by an earlier unit
+          {
+            bool ambig = false;
+            FileDef *ifd=findFileDef(Doxygen::inputNameLinkedMap,incFile.c_str(),ambig);
+            if (ifd && !ifd->isReference())
+            {
+              claimedFiles.insert(incFile);
+              tuIncludes[i].push_back(ifd);
+            }
+          }
+        }
+      }
+      {
+        // process source files (and the include files assigned to them) in parallel,
+        // every job uses its own translation unit
+        auto order = costOrder(tuFiles.size(),[&](size_t i)
+        {
+          return CostModel::instance().estimate(CostModel::Job::Source,tuFiles[i]->absFilePath(),tuSizes[i]);
+        });
+        ThreadPool threadPool(numClangThreads,"sources");
+        std::vector< std::future< std::shared_ptr<SourceContext> > > results;
+        for (size_t i : order)
+        {
+          size_t size = tuSizes[i];
+          auto ctx = std::make_shared<SourceContext>(tuFiles[i],*g_outputList);
+          const std::vector<FileDef*> &includes = tuIncludes[i];
+          auto processTU = [ctx,size,&includes,&processSourceFile]()
+          {
+            ChromeTrace::Span span("sources",ctx->fd->docName());
+            CostModel::Measurement measurement(CostModel::Job::Source,ctx->fd->absFilePath(),size);
+            auto clangParser = ClangParser::instance()->createTUParser(ctx->fd);
+            clangParser->parse();
+            processSourceFile(ctx->fd,ctx->ol,clangParser.get());
+            for (FileDef *ifd : includes)
+            {
+              processSourceFile(ifd,ctx->ol,clangParser.get());
+            }
+            return ctx;
+          };
+          results.emplace_back(threadPool.queue(processTU));
+        }
+        for (auto &f : results)
+        {
+          auto ctx = threadPool.wait(f);
+        }
+      }
+      {
+        // process remaining files
+        ThreadPool threadPool(numClangThreads,"sources");
+        std::vector< std::future< std::shared_ptr<SourceContext> > > results;
+        for (const auto &fn : *Doxygen::inputNameLinkedMap)
+        {
+          for (const auto &fd : *fn)
+          {
+            if (claimedFiles.find(fd->absFilePath().str())==claimedFiles.end()) // not yet processed
+            {
+              auto ctx = std::make_shared<SourceContext>(fd.get(),*g_outputList);
+              auto processFile = [ctx,&processSourceFile]()
+              {
+                ChromeTrace::Span span("sources",ctx->fd->docName());
+                if (ctx->fd->getLanguage()==SrcLangExt::Cpp) // C/C++ file, use clang parser
+                {
+                  auto clangParser = ClangParser::instance()->createTUParser(ctx->fd);
+                  clangParser->parse();
+                  processSourceFile(ctx->fd,ctx->ol,clangParser.get());
+                }
+                else // non C/C++ file, use built-in parser
+                {
+                  processSourceFile(ctx->fd,ctx->ol,nullptr);
+                }
+                return ctx;
+              };
+              results.emplace_back(threadPool.queue(processFile));
+            }
+          }
+        }
+        for (auto &f : results)
+        {
+          auto ctx = threadPool.wait(f);
+        }
+      }
+    }
+    else if (Doxygen::clangAssistedParsing)
     {
       StringUnorderedSet processedFiles;
 
@@ -8464,45 +8671,61 @@ static void generateFileSources()
           bool generateSourceFile;
           OutputList ol;
         };
-        ThreadPool threadPool(numThreads);
-        std::vector< std::future< std::shared_ptr<SourceContext> > > results;
+        std::vector<FileDef*> files;
+        std::vector<size_t> sizes;
         for (const auto &fn : *Doxygen::inputNameLinkedMap)
         {
           for (const auto &fd : *fn)
           {
-            bool generateSourceFile = fd->generateSourceFile() && !Htags::useHtags;
-            auto ctx = std::make_shared<SourceContext>(fd.get(),generateSourceFile,*g_outputList);
-            auto processFile = [ctx]()
-            {
-              if (ctx->generateSourceFile)
-              {
-                msg("Generating code for file %s...\n",qPrint(ctx->fd->docName()));
-              }
-              else
-              {
-                msg("Parsing code for file %s...\n",qPrint(ctx->fd->docName()));
-              }
-              StringVector filesInSameTu;
-              ctx->fd->getAllIncludeFilesRecursively(filesInSameTu);
-              if (ctx->generateSourceFile) // sources need to be shown in the output
-              {
-                ctx->fd->writeSourceHeader(ctx->ol);
-                ctx->fd->writeSourceBody(ctx->ol,nullptr);
-                ctx->fd->writeSourceFooter(ctx->ol);
-              }
-              else if (!ctx->fd->isReference() && Doxygen::parseSourcesNeeded)
-                // we needed to parse the sources even if we do not show them
-              {
-                ctx->fd->parseSource(nullptr);
-              }
-              return ctx;
-            };
-            results.emplace_back(threadPool.queue(processFile));
+            files.push_back(fd.get());
+            sizes.push_back(FileInfo(fd->absFilePath().str()).size());
           }
         }
+        // queue the files that took longest in the previous run first
+        auto order = costOrder(files.size(),[&](size_t i)
+        {
+          return CostModel::instance().estimate(CostModel::Job::Source,files[i]->absFilePath(),sizes[i]);
+        });
+        ThreadPool threadPool(numThreads,"sources");
+        std::vector< std::future< std::shared_ptr<SourceContext> > > results;
+        for (size_t i : order)
+        {
+          FileDef *fd = files[i];
+          size_t size = sizes[i];
+          bool generateSourceFile = fd->generateSourceFile() && !Htags::useHtags;
+          auto ctx = std::make_shared<SourceContext>(fd,generateSourceFile,*g_outputList);
+          auto processFile = [ctx,size]()
+          {
+            ChromeTrace::Span span("sources",ctx->fd->docName());
+            CostModel::Measurement measurement(CostModel::Job::Source,ctx->fd->absFilePath(),size);
+            if (ctx->generateSourceFile)
+            {
+              msg("Generating code for file %s...\n",qPrint(ctx->fd->docName()));
+            }
+            else
+            {
+              msg("Parsing code for file %s...\n",qPrint(ctx->fd->docName()));
+            }
+            StringVector filesInSameTu;
+            ctx->fd->getAllIncludeFilesRecursively(filesInSameTu);
+            if (ctx->generateSourceFile) // sources need to be shown in the output
+            {
+              ctx->fd->writeSourceHeader(ctx->ol);
+              ctx->fd->writeSourceBody(ctx->ol,nullptr);
+              ctx->fd->writeSourceFooter(ctx->ol);
+            }
+            else if (!ctx->fd->isReference() && Doxygen::parseSourcesNeeded)
+              // we needed to parse the sources even if we do not show them
+            {
+              ctx->fd->parseSource(nullptr);
+            }
+            return ctx;
+          };
+          results.emplace_back(threadPool.queue(processFile));
+        }
         for (auto &f : results)
         {
-          auto ctx = f.get();
+          auto ctx = threadPool.wait(f);
         }
       }
       else // single threaded version
@@ -8519,6 +8742,12 @@ static void generateFileSources()
       }
     }
   }
+#if USE_LIBCLANG
+  if (Doxygen::clangAssistedParsing)
+  {
+    ClangParser::instance()->clearTUCache(); // the translation units are not needed anymore
+  }
+#endif
 }
 
 //----------------------------------------------------------------------------
@@ -8539,7 +8768,7 @@ static void generateFileDocs()
         FileDef *fd;
         OutputList ol;
       };
-      ThreadPool threadPool(numThreads);
+      ThreadPool threadPool(numThreads,"filedocs");
       std::vector< std::future< std::shared_ptr<DocContext> > > results;
       for (const auto &fn : *Doxygen::inputNameLinkedMap)
       {
@@ -8560,7 +8789,7 @@ static void generateFileDocs()
       }
       for (auto &f : results)
       {
-        auto ctx = f.get();
+        auto ctx = threadPool.wait(f);
       }
     }
     else // single threaded processing
@@ -8755,7 +8984,7 @@ static void computeTooltipTexts()
   std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
   if (numThreads>1)
   {
-    ThreadPool threadPool(numThreads);
+    ThreadPool threadPool(numThreads,"tooltips");
     std::vector < std::future< void > > results;
     // queue the work
     for (const auto &[name,symList] : *Doxygen::symbolMap)
@@ -8775,7 +9004,7 @@ static void computeTooltipTexts()
     // wait for the results
     for (auto &f : results)
     {
-      f.get();
+      threadPool.wait(f);
     }
   }
   else
@@ -8863,18 +9092,28 @@ static void generateDocsForClassList(const std::vector<ClassDefMutable*> &classL
       ClassDefMutable *cd;
       OutputList ol;
     };
-    ThreadPool threadPool(numThreads);
+    // the number of members is used as the size of a class when it was not measured before
+    auto classSize = [](const ClassDefMutable *cd) { return cd->memberNameInfoLinkedMap().size()+1; };
+    auto order = costOrder(classList.size(),[&](size_t i)
+    {
+      return CostModel::instance().estimate(CostModel::Job::ClassDoc,classList[i]->name(),classSize(classList[i]));
+    });
+    ThreadPool threadPool(numThreads,"classdocs");
     std::vector< std::future< std::shared_ptr<DocContext> > > results;
-    for (const auto &cd : classList)
+    for (size_t i : order)
     {
+      ClassDefMutable *cd = classList[i];
       //printf("cd=%s getOuterScope=%p global=%p\n",qPrint(cd->name()),cd->getOuterScope(),Doxygen::globalScope);
       if (cd->getOuterScope()==nullptr || // <-- should not happen, but can if we read an old tag file
            cd->getOuterScope()==Doxygen::globalScope // only look at global classes
          )
       {
         auto ctx = std::make_shared<DocContext>(cd,*g_outputList);
-        auto processFile = [ctx]()
+        size_t size = classSize(cd);
+        auto processFile = [ctx,size]()
         {
+          ChromeTrace::Span span("classdocs",ctx->cd->displayName());
+          CostModel::Measurement measurement(CostModel::Job::ClassDoc,ctx->cd->name(),size);
           msg("Generating docs for compound %s...\n",qPrint(ctx->cd->displayName()));
 
           // skip external references, anonymous compounds and
@@ -8895,7 +9134,7 @@ static void generateDocsForClassList(const std::vector<ClassDefMutable*> &classL
     }
     for (auto &f : results)
     {
-      auto ctx = f.get();
+      auto ctx = threadPool.wait(f);
     }
   }
   else // single threaded processing
@@ -9185,19 +9424,7 @@ static void flushCachedTemplateRelations()
   // as there can be new template instances in the inheritance path
   // to this class. Optimization: only remove those classes that
   // have inheritance instances as direct or indirect sub classes.
-  StringVector elementsToRemove;
-  for (const auto &ci : *Doxygen::typeLookupCache)
-  {
-    const LookupInfo &li = ci.second;
-    if (li.definition)
-    {
-      elementsToRemove.push_back(ci.first);
-    }
-  }
-  for (const auto &k : elementsToRemove)
-  {
-    Doxygen::typeLookupCache->remove(k);
-  }
+  Doxygen::typeLookupCache->removeIf([](const LookupInfo &li) { return li.definition!=nullptr; });
 
   // remove all cached typedef resolutions whose target is a
   // template class as this may now be a template instance
@@ -9245,19 +9472,7 @@ static void flushUnresolvedRelations()
   // class B : public A {};
   // class C : public B::I {};
 
-  StringVector elementsToRemove;
-  for (const auto &ci : *Doxygen::typeLookupCache)
-  {
-    const LookupInfo &li = ci.second;
-    if (li.definition==nullptr && li.typeDef==nullptr)
-    {
-      elementsToRemove.push_back(ci.first);
-    }
-  }
-  for (const auto &k : elementsToRemove)
-  {
-    Doxygen::typeLookupCache->remove(k);
-  }
+  Doxygen::typeLookupCache->removeIf([](const LookupInfo &li) { return li.definition==nullptr && li.typeDef==nullptr; });
 
   // for each global function name
   for (const auto &fn : *Doxygen::functionNameLinkedMap)
@@ -9717,12 +9932,47 @@ static void generatePageDocs()
 {
   //printf("documentedPages=%d real=%d\n",documentedPages,Doxygen::pageLinkedMap->count());
   if (Index::instance().numDocumentedPages()==0) return;
-  for (const auto &pd : *Doxygen::pageLinkedMap)
+  std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
+  if (numThreads>1) // multi threaded processing
+  {
+    struct DocContext
+    {
+      DocContext(PageDef *pd_,const OutputList &ol_)
+        : pd(pd_), ol(ol_) {}
+      PageDef *pd;
+      OutputList ol;
+    };
+    ThreadPool threadPool(numThreads,"pagedocs");
+    std::vector< std::future< std::shared_ptr<DocContext> > > results;
+    for (const auto &pd : *Doxygen::pageLinkedMap)
+    {
+      if (!pd->getGroupDef() && !pd->isReference())
+      {
+        auto ctx = std::make_shared<DocContext>(pd.get(),*g_outputList);
+        auto processPage = [ctx]()
+        {
+          ChromeTrace::Span span("pagedocs",ctx->pd->name());
+          msg("Generating docs for page %s...\n",qPrint(ctx->pd->name()));
+          ctx->pd->writeDocumentation(ctx->ol);
+          return ctx;
+        };
+        results.emplace_back(threadPool.queue(processPage));
+      }
+    }
+    for (auto &f : results)
+    {
+      auto ctx = threadPool.wait(f);
+    }
+  }
+  else // single threaded processing
   {
-    if (!pd->getGroupDef() && !pd->isReference())
+    for (const auto &pd : *Doxygen::pageLinkedMap)
     {
-      msg("Generating docs for page %s...\n",qPrint(pd->name()));
-      pd->writeDocumentation(*g_outputList);
+      if (!pd->getGroupDef() && !pd->isReference())
+      {
+        msg("Generating docs for page %s...\n",qPrint(pd->name()));
+        pd->writeDocumentation(*g_outputList);
+      }
     }
   }
 }
@@ -9858,47 +10108,109 @@ void printSectionsTree()
 }
 
 
+//----------------------------------------------------------------------------
+
+//! Frees the Entry tree \a root and then the pool its nodes were allocated from.
+//! With multiple threads this is done in the background while processing continues,
+//! cleanUpDoxygen() waits for it to finish.
+static void releaseEntryTree(std::shared_ptr<Entry> &&root)
+{
+  auto release = [](std::shared_ptr<Entry> tree)
+  {
+    ChromeTrace::Span span("entries","releasing entry tree");
+    tree.reset();
+    if (!releaseEntryPool())
+    {
+      Debug::print(Debug::Time,0,"Entry pool not released, some entries are still in use\n");
+    }
+  };
+  if (Config_getInt(NUM_PROC_THREADS)>1)
+  {
+    g_entryTreeReleased = std::async(std::launch::async,release,std::move(root));
+  }
+  else
+  {
+    release(std::move(root));
+  }
+}
+
 //----------------------------------------------------------------------------
 // generate the example documentation
 
+static void generateExampleDoc(const PageDef *pd,OutputList &ol)
+{
+  msg("Generating docs for example %s...\n",qPrint(pd->name()));
+  SrcLangExt lang = getLanguageFromFileName(pd->name(), SrcLangExt::Unknown);
+  if (lang != SrcLangExt::Unknown)
+  {
+    QCString ext = getFileNameExtension(pd->name());
+    auto intf = Doxygen::parserManager->getCodeParser(ext);
+    intf->resetCodeParserState();
+  }
+  QCString n=pd->getOutputFileBase();
+  startFile(ol,n,n,pd->name());
+  startTitle(ol,n);
+  ol.docify(pd->name());
+  endTitle(ol,n,QCString());
+  ol.startContents();
+  QCString lineNoOptStr;
+  if (pd->showLineNo())
+  {
+    lineNoOptStr="{lineno}";
+  }
+  ol.generateDoc(pd->docFile(),                       // file
+                 pd->docLine(),                       // startLine
+                 pd,                                  // context
+                 nullptr,                             // memberDef
+                 (pd->briefDescription().isEmpty()?"":pd->briefDescription()+"\n\n")+
+                 pd->documentation()+"\n\n\\include"+lineNoOptStr+" "+pd->name(), // docs
+                 TRUE,                                // index words
+                 TRUE,                                // is example
+                 pd->name(),
+                 FALSE,
+                 FALSE,
+                 Config_getBool(MARKDOWN_SUPPORT)
+                );
+  endFile(ol); // contains ol.endContents()
+}
+
 static void generateExampleDocs()
 {
   g_outputList->disable(OutputType::Man);
-  for (const auto &pd : *Doxygen::exampleLinkedMap)
-  {
-    msg("Generating docs for example %s...\n",qPrint(pd->name()));
-    SrcLangExt lang = getLanguageFromFileName(pd->name(), SrcLangExt::Unknown);
-    if (lang != SrcLangExt::Unknown)
-    {
-      QCString ext = getFileNameExtension(pd->name());
-      auto intf = Doxygen::parserManager->getCodeParser(ext);
-      intf->resetCodeParserState();
-    }
-    QCString n=pd->getOutputFileBase();
-    startFile(*g_outputList,n,n,pd->name());
-    startTitle(*g_outputList,n);
-    g_outputList->docify(pd->name());
-    endTitle(*g_outputList,n,QCString());
-    g_outputList->startContents();
-    QCString lineNoOptStr;
-    if (pd->showLineNo())
-    {
-      lineNoOptStr="{lineno}";
-    }
-    g_outputList->generateDoc(pd->docFile(),                       // file
-                         pd->docLine(),                            // startLine
-                         pd.get(),                                 // context
-                         nullptr,                                  // memberDef
-                         (pd->briefDescription().isEmpty()?"":pd->briefDescription()+"\n\n")+
-                         pd->documentation()+"\n\n\\include"+lineNoOptStr+" "+pd->name(), // docs
-                         TRUE,                                     // index words
-                         TRUE,                                     // is example
-                         pd->name(),
-                         FALSE,
-                         FALSE,
-                         Config_getBool(MARKDOWN_SUPPORT)
-                        );
-    endFile(*g_outputList); // contains g_outputList->endContents()
+  std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
+  if (numThreads>1) // multi threaded processing
+  {
+    struct DocContext
+    {
+      DocContext(const PageDef *pd_,const OutputList &ol_)
+        : pd(pd_), ol(ol_) {}
+      const PageDef *pd;
+      OutputList ol;
+    };
+    ThreadPool threadPool(numThreads,"exampledocs");
+    std::vector< std::future< std::shared_ptr<DocContext> > > results;
+    for (const auto &pd : *Doxygen::exampleLinkedMap)
+    {
+      auto ctx = std::make_shared<DocContext>(pd.get(),*g_outputList);
+      auto processExample = [ctx]()
+      {
+        ChromeTrace::Span span("exampledocs",ctx->pd->name());
+        generateExampleDoc(ctx->pd,ctx->ol);
+        return ctx;
+      };
+      results.emplace_back(threadPool.queue(processExample));
+    }
+    for (auto &f : results)
+    {
+      auto ctx = threadPool.wait(f);
+    }
+  }
+  else // single threaded processing
+  {
+    for (const auto &pd : *Doxygen::exampleLinkedMap)
+    {
+      generateExampleDoc(pd.get(),*g_outputList);
+    }
   }
   g_outputList->enable(OutputType::Man);
 }
@@ -9908,11 +10220,45 @@ static void generateExampleDocs()
 
 static void generateGroupDocs()
 {
-  for (const auto &gd : *Doxygen::groupLinkedMap)
+  std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
+  if (numThreads>1) // multi threaded processing
+  {
+    struct DocContext
+    {
+      DocContext(GroupDef *gd_,const OutputList &ol_)
+        : gd(gd_), ol(ol_) {}
+      GroupDef *gd;
+      OutputList ol;
+    };
+    ThreadPool threadPool(numThreads,"groupdocs");
+    std::vector< std::future< std::shared_ptr<DocContext> > > results;
+    for (const auto &gd : *Doxygen::groupLinkedMap)
+    {
+      if (!gd->isReference())
+      {
+        auto ctx = std::make_shared<DocContext>(gd.get(),*g_outputList);
+        auto processGroup = [ctx]()
+        {
+          ChromeTrace::Span span("groupdocs",ctx->gd->name());
+          ctx->gd->writeDocumentation(ctx->ol);
+          return ctx;
+        };
+        results.emplace_back(threadPool.queue(processGroup));
+      }
+    }
+    for (auto &f : results)
+    {
+      auto ctx = threadPool.wait(f);
+    }
+  }
+  else // single threaded processing
   {
-    if (!gd->isReference())
+    for (const auto &gd : *Doxygen::groupLinkedMap)
     {
-      gd->writeDocumentation(*g_outputList);
+      if (!gd->isReference())
+      {
+        gd->writeDocumentation(*g_outputList);
+      }
     }
   }
 }
@@ -9932,7 +10278,7 @@ static void generateNamespaceClassDocs(const ClassLinkedRefMap &classList)
       ClassDefMutable *cdm;
       OutputList ol;
     };
-    ThreadPool threadPool(numThreads);
+    ThreadPool threadPool(numThreads,"classdocs");
     std::vector< std::future< std::shared_ptr<DocContext> > > results;
     // for each class in the namespace...
     for (const auto &cd : classList)
@@ -9943,6 +10289,7 @@ static void generateNamespaceClassDocs(const ClassLinkedRefMap &classList)
         auto ctx = std::make_shared<DocContext>(cdm,*g_outputList);
         auto processFile = [ctx]()
         {
+          ChromeTrace::Span span("classdocs",ctx->cdm->displayName());
           if ( ( ctx->cdm->isLinkableInProject() &&
                 ctx->cdm->templateMaster()==nullptr
                ) // skip external references, anonymous compounds and
@@ -9963,7 +10310,7 @@ static void generateNamespaceClassDocs(const ClassLinkedRefMap &classList)
     // wait for the results
     for (auto &f : results)
     {
-      auto ctx = f.get();
+      auto ctx = threadPool.wait(f);
     }
   }
   else // single threaded processing
@@ -10512,6 +10859,8 @@ static std::shared_ptr<Entry> parseFile(OutlineParserInterface &parser,
 {
   QCString fileName=fn;
   AUTO_TRACE("fileName={}",fileName);
+  ChromeTrace::Span span("parse",fileName);
+  CostModel::Measurement measurement(CostModel::Job::Parse,fileName,FileInfo(fileName.str()).size());
   QCString extension;
   int ei = fileName.findRev('.');
   if (ei!=-1)
@@ -10523,39 +10872,78 @@ static std::shared_ptr<Entry> parseFile(OutlineParserInterface &parser,
     extension = ".no_extension";
   }
 
-  FileInfo fi(fileName.str());
-  std::string preBuf;
+  std::string inBuf;
+  readInputFile(fileName,inBuf);
+  addTerminalCharIfMissing(inBuf,'\n');
+
+  // the results of the clang parser depend on the whole translation unit, so do not cache those
+  ParseCache &parseCache = ParseCache::instance();
+  bool useCache = parseCache.isEnabled() && clangParser==nullptr;
+  std::string hash;
+  if (useCache)
+  {
+    hash = ParseCache::contentHash(inBuf);
+    std::shared_ptr<Entry> fileRoot = parseCache.find(fileName,hash);
+    if (fileRoot)
+    {
+      msg("Reading %s from cache...\n",qPrint(fn));
+      fileRoot->setFileDef(fd);
+      return fileRoot;
+    }
+  }
+
+  ParseCache::Recorder recorder;
+  std::string convBuf;
+  convBuf.reserve(inBuf.size()+1024);
+  std::unique_ptr<Preprocessor> preprocessor;
 
   if (Config_getBool(ENABLE_PREPROCESSING) &&
       parser.needsPreprocessing(extension))
   {
-    Preprocessor preprocessor;
+    preprocessor = std::make_unique<Preprocessor>();
     const StringVector &includePath = Config_getList(INCLUDE_PATH);
     for (const auto &s : includePath)
     {
       std::string absPath = FileInfo(s).absFilePath();
-      preprocessor.addSearchDir(absPath.c_str());
+      preprocessor->addSearchDir(absPath.c_str());
     }
-    std::string inBuf;
     msg("Preprocessing %s...\n",qPrint(fn));
-    readInputFile(fileName,inBuf);
-    addTerminalCharIfMissing(inBuf,'\n');
-    preprocessor.processFile(fileName,inBuf,preBuf);
+    if (Config_getBool(PIPELINED_PARSING) && getLanguageFromFileName(fileName)!=SrcLangExt::Fortran)
+    {
+      // run the preprocessor on its own thread and convert the comments while the output is produced.
+      // This is a plain thread rather than a task, since it blocks when the reader falls behind.
+      StreamPipe pipe(g_pipeCapacity);
+      bool preprocessorCacheable = true;
+      std::thread producer([&]()
+      {
+        ChromeTrace::Span preSpan("preprocess",fileName);
+        ParseCache::Recorder preprocessorRecorder;
+        preprocessor->processFile(fileName,inBuf,pipe);
+        preprocessorCacheable = preprocessorRecorder.isCacheable();
+        pipe.close();
+      });
+      convertCppComments(pipe,convBuf,fileName.str());
+      producer.join();
+      if (!preprocessorCacheable) ParseCache::markUncacheable();
+    }
+    else
+    {
+      std::string preBuf;
+      preprocessor->processFile(fileName,inBuf,preBuf);
+      std::string().swap(inBuf); // no longer needed
+      // convert multi-line C++ comments to C style comments
+      convertCppComments(preBuf,convBuf,fileName.str());
+    }
   }
   else // no preprocessing
   {
     msg("Reading %s...\n",qPrint(fn));
-    readInputFile(fileName,preBuf);
-    addTerminalCharIfMissing(preBuf,'\n');
+    // convert multi-line C++ comments to C style comments
+    convertCppComments(inBuf,convBuf,fileName.str());
   }
+  std::string().swap(inBuf); // only the converted text is needed for parsing
 
-  std::string convBuf;
-  convBuf.reserve(preBuf.size()+1024);
-
-  // convert multi-line C++ comments to C style comments
-  convertCppComments(preBuf,convBuf,fileName.str());
-
-  std::shared_ptr<Entry> fileRoot = std::make_shared<Entry>();
+  std::shared_ptr<Entry> fileRoot = makeEntry();
   // use language parse to parse the file
   if (clangParser)
   {
@@ -10563,6 +10951,12 @@ static std::shared_ptr<Entry> parseFile(OutlineParserInterface &parser,
     clangParser->switchToFile(fd);
   }
   parser.parseInput(fileName,convBuf.data(),fileRoot,clangParser);
+  if (useCache && recorder.isCacheable())
+  {
+    parseCache.store(fileName,hash,
+                     preprocessor ? preprocessor->footprint() : Preprocessor::Footprint(),
+                     *fileRoot);
+  }
   fileRoot->setFileDef(fd);
   return fileRoot;
 }
@@ -10587,7 +10981,7 @@ static void parseFilesMultiThreading(const std::shared_ptr<Entry> &root)
     // process source files (and their include dependencies)
     std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
     msg("Processing input using %zu threads.\n",numThreads);
-    ThreadPool threadPool(numThreads);
+    ThreadPool threadPool(numThreads,"parse");
     using FutureType = std::vector< std::shared_ptr<Entry> >;
     std::vector< std::future< FutureType > > results;
     for (const auto &s : g_inputFiles)
@@ -10631,6 +11025,7 @@ static void parseFilesMultiThreading(const std::shared_ptr<Entry> &root)
               }
             }
           }
+          ClangParser::instance()->keepTUParser(std::move(clangParser));
           return roots;
         };
         // dispatch the work and collect the future results
@@ -10640,7 +11035,7 @@ static void parseFilesMultiThreading(const std::shared_ptr<Entry> &root)
     // synchronise with the Entry result lists produced and add them to the root
     for (auto &f : results)
     {
-      auto l = f.get();
+      auto l = threadPool.wait(f);
       for (auto &e : l)
       {
         root->moveToSubEntryAndKeep(e);
@@ -10664,6 +11059,7 @@ static void parseFilesMultiThreading(const std::shared_ptr<Entry> &root)
             auto clangParser = ClangParser::instance()->createTUParser(fd);
             auto fileRoot = parseFile(*parser.get(),fd,s.c_str(),clangParser.get(),true);
             roots.push_back(fileRoot);
+            ClangParser::instance()->keepTUParser(std::move(clangParser));
           }
           else
           {
@@ -10678,7 +11074,7 @@ static void parseFilesMultiThreading(const std::shared_ptr<Entry> &root)
     // synchronise with the Entry result lists produced and add them to the root
     for (auto &f : results)
     {
-      auto l = f.get();
+      auto l = threadPool.wait(f);
       for (auto &e : l)
       {
         root->moveToSubEntryAndKeep(e);
@@ -10690,11 +11086,18 @@ static void parseFilesMultiThreading(const std::shared_ptr<Entry> &root)
   {
     std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
     msg("Processing input using %zu threads.\n",numThreads);
-    ThreadPool threadPool(numThreads);
+    ThreadPool threadPool(numThreads,"parse");
     using FutureType = std::shared_ptr<Entry>;
-    std::vector< std::future< FutureType > > results;
-    for (const auto &s : g_inputFiles)
+    std::vector< std::future< FutureType > > results(g_inputFiles.size());
+    // queue the largest files first, the results are collected in input order
+    auto order = costOrder(g_inputFiles.size(),[](size_t i)
     {
+      const std::string &s = g_inputFiles[i];
+      return CostModel::instance().estimate(CostModel::Job::Parse,QCString(s),FileInfo(s).size());
+    });
+    for (size_t i : order)
+    {
+      const std::string &s = g_inputFiles[i];
       // lambda representing the work to executed by a thread
       auto processFile = [s]() {
         bool ambig = false;
@@ -10704,12 +11107,12 @@ static void parseFilesMultiThreading(const std::shared_ptr<Entry> &root)
         return fileRoot;
       };
       // dispatch the work and collect the future results
-      results.emplace_back(threadPool.queue(processFile));
+      results[i] = threadPool.queue(processFile);
     }
     // synchronise with the Entry results produced and add them to the root
     for (auto &f : results)
     {
-      root->moveToSubEntryAndKeep(f.get());
+      root->moveToSubEntryAndKeep(threadPool.wait(f));
     }
   }
 }
@@ -10762,6 +11165,7 @@ static void parseFilesSingleThreading(const std::shared_ptr<Entry> &root)
             }
           }
         }
+        ClangParser::instance()->keepTUParser(std::move(clangParser));
       }
     }
     // process remaining files
@@ -10777,6 +11181,7 @@ static void parseFilesSingleThreading(const std::shared_ptr<Entry> &root)
           auto parser { getParserForFile(s.c_str()) };
           auto fileRoot = parseFile(*parser.get(),fd,s.c_str(),clangParser.get(),true);
           root->moveToSubEntryAndKeep(fileRoot);
+          ClangParser::instance()->keepTUParser(std::move(clangParser));
         }
         else
         {
@@ -11116,6 +11521,7 @@ static void devUsage()
 #endif
   msg("  -d <level>  enable a debug level, such as (multiple invocations of -d are possible):\n");
   Debug::printFlags();
+  msg("\ttrace=<file> (writes a profile of the run in Chrome trace event format to <file>)\n");
 }
 
 
@@ -11291,6 +11697,8 @@ void initDoxygen()
 
 void cleanUpDoxygen()
 {
+  if (g_entryTreeReleased.valid()) g_entryTreeReleased.wait();
+  ChromeTrace::instance().stop();
   FormulaManager::instance().clear();
   SectionManager::instance().clear();
   ModuleManager::instance().clear();
@@ -11401,6 +11809,11 @@ void readConfiguration(int argc, char **argv)
             cleanUpDoxygen();
             exit(0);
           }
+          if (debugLabel.startsWith("trace="))
+          {
+            ChromeTrace::instance().start(debugLabel.mid(6));
+            break;
+          }
           int retVal = Debug::setFlagStr(debugLabel);
           if (!retVal)
           {
@@ -12302,8 +12715,11 @@ void parseInput()
   if (cacheSize<0) cacheSize=0;
   if (cacheSize>9) cacheSize=9;
   uint32_t lookupSize = 65536 << cacheSize;
-  Doxygen::typeLookupCache = new Cache<std::string,LookupInfo>(lookupSize);
-  Doxygen::symbolLookupCache = new Cache<std::string,LookupInfo>(lookupSize);
+  Doxygen::typeLookupCache = new ConcurrentCache<LookupInfo>(lookupSize);
+  Doxygen::symbolLookupCache = new ConcurrentCache<LookupInfo>(lookupSize);
+  size_t cacheMemory = static_cast<size_t>(Config_getInt(LOOKUP_CACHE_MEMORY))*1024*1024;
+  Doxygen::typeLookupCache->setMemoryLimit(cacheMemory);
+  Doxygen::symbolLookupCache->setMemoryLimit(cacheMemory);
 
 #ifdef HAS_SIGNALS
   signal(SIGINT, stopDoxygen);
@@ -12482,7 +12898,7 @@ void parseInput()
    *             Handle Tag Files                                           *
    **************************************************************************/
 
-  std::shared_ptr<Entry> root = std::make_shared<Entry>();
+  std::shared_ptr<Entry> root = makeEntry();
   msg("Reading and parsing tag files\n");
 
   const StringVector &tagFileList = Config_getList(TAGFILES);
@@ -12498,6 +12914,12 @@ void parseInput()
   addSTLSupport(root);
 
   g_s.begin("Parsing files\n");
+  ParseCache::instance().initialize();
+  ParseCache::instance().restoreIncludeMacros();
+  if (Config_getInt(NUM_PROC_THREADS)>1)
+  {
+    CostModel::instance().load();
+  }
   if (Config_getInt(NUM_PROC_THREADS)==1)
   {
     parseFilesSingleThreading(root);
@@ -12506,6 +12928,8 @@ void parseInput()
   {
     parseFilesMultiThreading(root);
   }
+  ParseCache::instance().storeIncludeMacros();
+  ParseCache::instance().printStatistics();
   g_s.end();
 
   /**************************************************************************
@@ -12703,6 +13127,11 @@ void parseInput()
   findGroupScope(root.get());
   g_s.end();
 
+  printNavTree(root.get(),0);
+
+  // all information of the Entry tree has been transferred to the definitions by now
+  releaseEntryTree(std::move(root));
+
   g_s.begin("Computing module relations...\n");
   auto &mm = ModuleManager::instance();
   mm.resolvePartitions();
@@ -12787,6 +13216,7 @@ void parseInput()
 
   g_s.begin("Computing member references...\n");
   computeMemberReferences();
+  initLinkifyFilter();
   g_s.end();
 
   if (Config_getBool(INHERIT_DOCS))
@@ -12820,21 +13250,20 @@ void parseInput()
   setAnonymousEnumType();
   g_s.end();
 
-  g_s.begin("Computing dependencies between directories...\n");
-  computeDirDependencies();
-  g_s.end();
-
-  g_s.begin("Generating citations page...\n");
-  CitationManager::instance().generatePage();
-  g_s.end();
-
-  g_s.begin("Counting members...\n");
-  countMembers();
-  g_s.end();
-
-  g_s.begin("Counting data structures...\n");
-  Index::instance().countDataStructures();
-  g_s.end();
+  {
+    // running bibtex for the citations page can overlap with the counting of members
+    PhaseScheduler scheduler;
+    scheduler.add("Computing dependencies between directories...\n",{"files"},{"dirs"},
+        []() { computeDirDependencies(); });
+    scheduler.add("Generating citations page...\n",{"citations"},{"pages","sections","cwd"},
+        []() { CitationManager::instance().generatePage(); });
+    scheduler.add("Counting members...\n",{},{"memberCounts"},
+        []() { countMembers(); });
+    scheduler.add("Counting data structures...\n",{"dirs","pages","memberCounts"},{"index"},
+        []() { Index::instance().countDataStructures(); });
+    scheduler.run(static_cast<size_t>(Config_getInt(NUM_PROC_THREADS)));
+    g_s.add(scheduler);
+  }
 
   g_s.begin("Resolving user defined references...\n");
   resolveUserReferences();
@@ -12862,6 +13291,9 @@ void parseInput()
   vhdlCorrectMemberProperties();
   g_s.end();
 
+  // the symbol tables are complete, so parsed documentation blocks can be reused from here on
+  DocAstCache::instance().setEnabled(true);
+
   g_s.begin("Computing tooltip texts...\n");
   computeTooltipTexts();
   g_s.end();
@@ -12879,7 +13311,6 @@ void parseInput()
     }
   }
 
-  printNavTree(root.get(),0);
   printSectionsTree();
 }
 
@@ -12944,6 +13375,9 @@ void generateOutput()
        err("htags(1) ended normally but failed to load the filemap. \n");
   }
 
+  // the symbol table is complete now, so lookups stored by an earlier run are valid again
+  loadLookupCaches();
+
   /**************************************************************************
    *                        Generate documentation                          *
    **************************************************************************/
@@ -13089,103 +13523,109 @@ void generateOutput()
   Doxygen::indexList->finalize();
   g_s.end();
 
-  g_s.begin("writing tag file...\n");
-  writeTagFile();
-  g_s.end();
+  // The remaining phases only read the symbol model and each writes its own output,
+  // so they can overlap, except for the ones changing the working directory. The phases are listed in the order they run when using one thread.
+  // The code and documentation parsers used by the XML, SQLite3 and Perl module output add words to
+  // the search index, and dot and plantuml both depend on the process environment (DOTFONTPATH).
+  PhaseScheduler scheduler;
+  StringVector searchIndexWrites;
+  if (Doxygen::searchIndex.enabled()) searchIndexWrites.push_back("searchindex");
+  auto withSearchIndex = [&searchIndexWrites](StringVector writes)
+  {
+    writes.insert(writes.end(),searchIndexWrites.begin(),searchIndexWrites.end());
+    return writes;
+  };
+  scheduler.add("writing tag file...\n",{"cwd"},{"tagfile"},
+      []() { writeTagFile(); });
 
   if (Config_getBool(GENERATE_XML))
   {
-    g_s.begin("Generating XML output...\n");
-    Doxygen::generatingXmlOutput=TRUE;
-    generateXML();
-    Doxygen::generatingXmlOutput=FALSE;
-    g_s.end();
+    scheduler.add("Generating XML output...\n",{"cwd"},withSearchIndex({"xml"}),
+        []() { generateXML(); });
   }
   if (Config_getBool(GENERATE_SQLITE3))
   {
-    g_s.begin("Generating SQLITE3 output...\n");
-    generateSqlite3();
-    g_s.end();
+    scheduler.add("Generating SQLITE3 output...\n",{"cwd"},withSearchIndex({"sqlite3"}),
+        []() { generateSqlite3(); });
   }
 
   if (Config_getBool(GENERATE_AUTOGEN_DEF))
   {
-    g_s.begin("Generating AutoGen DEF output...\n");
-    generateDEF();
-    g_s.end();
+    scheduler.add("Generating AutoGen DEF output...\n",{"cwd"},{"def"},
+        []() { generateDEF(); });
   }
   if (Config_getBool(GENERATE_PERLMOD))
   {
-    g_s.begin("Generating Perl module output...\n");
-    generatePerlMod();
-    g_s.end();
+    scheduler.add("Generating Perl module output...\n",{"cwd"},withSearchIndex({"perlmod"}),
+        []() { generatePerlMod(); });
   }
   if (generateHtml && searchEngine && serverBasedSearch)
   {
-    g_s.begin("Generating search index\n");
-    if (Doxygen::searchIndex.kind()==SearchIndexIntf::Internal) // write own search index
-    {
-      HtmlGenerator::writeSearchPage();
-      Doxygen::searchIndex.write(Config_getString(HTML_OUTPUT)+"/search/search.idx");
-    }
-    else // write data for external search index
-    {
-      HtmlGenerator::writeExternalSearchPage();
-      QCString searchDataFile = Config_getString(SEARCHDATA_FILE);
-      if (searchDataFile.isEmpty())
-      {
-        searchDataFile="searchdata.xml";
-      }
-      if (!Portable::isAbsolutePath(searchDataFile.data()))
-      {
-        searchDataFile.prepend(Config_getString(OUTPUT_DIRECTORY)+"/");
-      }
-      Doxygen::searchIndex.write(searchDataFile);
-    }
-    g_s.end();
+    scheduler.add("Generating search index\n",{"cwd"},{"html","searchindex"},
+        []() {
+          if (Doxygen::searchIndex.kind()==SearchIndexIntf::Internal) // write own search index
+          {
+            HtmlGenerator::writeSearchPage();
+            Doxygen::searchIndex.write(Config_getString(HTML_OUTPUT)+"/search/search.idx");
+          }
+          else // write data for external search index
+          {
+            HtmlGenerator::writeExternalSearchPage();
+            QCString searchDataFile = Config_getString(SEARCHDATA_FILE);
+            if (searchDataFile.isEmpty())
+            {
+              searchDataFile="searchdata.xml";
+            }
+            if (!Portable::isAbsolutePath(searchDataFile.data()))
+            {
+              searchDataFile.prepend(Config_getString(OUTPUT_DIRECTORY)+"/");
+            }
+            Doxygen::searchIndex.write(searchDataFile);
+          }
+        });
   }
 
   if (generateRtf)
   {
-    g_s.begin("Combining RTF output...\n");
-    if (!RTFGenerator::preProcessFileInplace(Config_getString(RTF_OUTPUT),"refman.rtf"))
-    {
-      err("An error occurred during post-processing the RTF files!\n");
-    }
-    g_s.end();
+    scheduler.add("Combining RTF output...\n",{"cwd"},{"rtf"},
+        []() {
+          if (!RTFGenerator::preProcessFileInplace(Config_getString(RTF_OUTPUT),"refman.rtf"))
+          {
+            err("An error occurred during post-processing the RTF files!\n");
+          }
+        });
   }
 
-  g_s.begin("Running plantuml with JAVA...\n");
-  PlantumlManager::instance().run();
-  g_s.end();
+  scheduler.add("Running plantuml with JAVA...\n",{"cwd"},{"plantuml","env"},
+      []() { PlantumlManager::instance().run(); });
 
   if (Config_getBool(HAVE_DOT))
   {
-    g_s.begin("Running dot...\n");
-    DotManager::instance()->run();
-    g_s.end();
+    scheduler.add("Running dot...\n",{"cwd"},{"dot","env"},
+        []() { DotManager::instance()->run(); });
   }
 
   if (generateHtml &&
       Config_getBool(GENERATE_HTMLHELP) &&
       !Config_getString(HHC_LOCATION).isEmpty())
   {
-    g_s.begin("Running html help compiler...\n");
-    runHtmlHelpCompiler();
-    g_s.end();
+    scheduler.add("Running html help compiler...\n",{"html","plantuml","dot"},{"chm","cwd"},
+        []() { runHtmlHelpCompiler(); });
   }
 
   if ( generateHtml &&
        Config_getBool(GENERATE_QHP) &&
       !Config_getString(QHG_LOCATION).isEmpty())
   {
-    g_s.begin("Running qhelpgenerator...\n");
-    runQHelpGenerator();
-    g_s.end();
+    scheduler.add("Running qhelpgenerator...\n",{"html","plantuml","dot"},{"qch","cwd"},
+        []() { runQHelpGenerator(); });
   }
+  scheduler.run(static_cast<size_t>(Config_getInt(NUM_PROC_THREADS)));
+  g_s.add(scheduler);
 
   g_outputList->cleanup();
 
+  saveLookupCaches();
   msg("type lookup cache used %zu/%zu hits=%" PRIu64 " misses=%" PRIu64 "\n",
       Doxygen::typeLookupCache->size(),
       Doxygen::typeLookupCache->capacity(),
@@ -13196,10 +13636,16 @@ void generateOutput()
       Doxygen::symbolLookupCache->capacity(),
       Doxygen::symbolLookupCache->hits(),
       Doxygen::symbolLookupCache->misses());
+  DocAstCache::instance().printStatistics();
+  DocAstCache::instance().setEnabled(false);
   int typeCacheParam   = computeIdealCacheParam(static_cast<size_t>(Doxygen::typeLookupCache->misses()*2/3)); // part of the cache is flushed, hence the 2/3 correction factor
   int symbolCacheParam = computeIdealCacheParam(static_cast<size_t>(Doxygen::symbolLookupCache->misses()));
   int cacheParam = std::max(typeCacheParam,symbolCacheParam);
-  if (cacheParam>Config_getInt(LOOKUP_CACHE_SIZE))
+  if (Config_getInt(LOOKUP_CACHE_MEMORY)>0)
+  {
+    g_s.printLookupCaches();
+  }
+  else if (cacheParam>Config_getInt(LOOKUP_CACHE_SIZE))
   {
     msg("Note: based on cache misses the ideal setting for LOOKUP_CACHE_SIZE is %d at the cost of higher memory usage.\n",cacheParam);
   }
@@ -13224,6 +13670,10 @@ void generateOutput()
     msg("finished...\n");
   }
 
+  if (Config_getInt(NUM_PROC_THREADS)>1)
+  {
+    CostModel::instance().save();
+  }
 
   /**************************************************************************
    *                        Start cleaning up                               *
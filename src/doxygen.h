@@ -124,16 +124,16 @@ class Doxygen
     static SearchIndexIntf           searchIndex;
     static SymbolMap<Definition>    *symbolMap;
     static ClangUsrMap              *clangUsrMap;
-    static Cache<std::string,LookupInfo> *typeLookupCache;
-    static Cache<std::string,LookupInfo> *symbolLookupCache;
+    static ConcurrentCache<LookupInfo>      *typeLookupCache;
+    static ConcurrentCache<LookupInfo>      *symbolLookupCache;
     static DirLinkedMap             *dirLinkedMap;
     static DirRelationLinkedMap      dirRelations;
     static ParserManager            *parserManager;
-    static bool                      suppressDocWarnings;
+    static thread_local bool         suppressDocWarnings; //!< set per thread, see generatingXmlOutput
     static QCString                  filterDBFileName;
     static IndexList                *indexList;
     static QCString                  spaces;
-    static bool                      generatingXmlOutput;
+    static thread_local bool         generatingXmlOutput; //!< set per thread, other output may be generated in parallel
     static DefinesPerFileList        macroDefinitions;
     static bool                      clangAssistedParsing;
     static QCString                  verifiedDotPath;
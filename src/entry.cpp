@@ -17,6 +17,9 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cstddef>
+#include <limits>
+#include <mutex>
 #include <stdlib.h>
 
 #include "entry.h"
@@ -28,6 +31,173 @@
 
 //------------------------------------------------------------------
 
+/** Pool providing the memory for the Entry objects created by makeEntry(), together
+ *  with their shared_ptr control block, so all slots have the same size.
+ *
+ *  Each thread keeps a cache of free slots, so allocating and freeing an entry
+ *  normally does not need a lock. When no pooled entry is alive anymore, release()
+ *  frees all blocks at once. Since the caches of other threads cannot be cleared
+ *  from the releasing thread, each successful release starts a new generation and
+ *  a cache of an older generation is discarded on first use.
+ */
+class EntryPool
+{
+  public:
+    static EntryPool &instance()
+    {
+      // Intentionally never destroyed, static containers may still hold entries at exit.
+      static EntryPool *pool = new EntryPool;
+      return *pool;
+    }
+
+    void *allocate(size_t size)
+    {
+      if (!usePool(size)) return ::operator new(size);
+      if (m_live++>=g_releasing) // a release is in progress, wait for it before using the cache
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+      }
+      ThreadCache &cache = threadCache();
+      if (cache.slots.empty())
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_free.empty()) addBlock();
+        size_t n = std::min(g_batchSize,m_free.size());
+        cache.slots.insert(cache.slots.end(),m_free.end()-static_cast<std::ptrdiff_t>(n),m_free.end());
+        m_free.resize(m_free.size()-n);
+      }
+      void *slot = cache.slots.back();
+      cache.slots.pop_back();
+      return slot;
+    }
+
+    void deallocate(void *slot,size_t size)
+    {
+      if (!usePool(size)) { ::operator delete(slot); return; }
+      ThreadCache &cache = threadCache();
+      cache.slots.push_back(slot);
+      if (cache.slots.size()>=2*g_batchSize) // give part of the cache back
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_free.insert(m_free.end(),cache.slots.end()-static_cast<std::ptrdiff_t>(g_batchSize),cache.slots.end());
+        cache.slots.resize(cache.slots.size()-g_batchSize);
+      }
+      m_live--;
+    }
+
+    bool release()
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      // Marking the pool as releasing in the same step that checks for live entries
+      // guarantees that a thread that concurrently starts an allocation either prevents
+      // the release or waits for it to finish, so the thread caches stay valid when the
+      // release fails.
+      size_t live = 0;
+      if (!m_live.compare_exchange_strong(live,g_releasing)) return false;
+      m_generation++;
+      for (char *block : m_blocks) free(block);
+      m_blocks.clear();
+      m_free.clear();
+      m_free.shrink_to_fit();
+      m_live-=g_releasing;
+      return true;
+    }
+
+  private:
+    static constexpr size_t g_slotsPerBlock = 4096;
+    static constexpr size_t g_batchSize     = 256;
+    static constexpr size_t g_releasing     = std::numeric_limits<size_t>::max()/2;
+
+    struct ThreadCache
+    {
+      std::vector<void*> slots;
+      uint64_t generation = 0;
+    };
+
+    EntryPool() = default;
+
+    ThreadCache &threadCache()
+    {
+      // not destroyed at thread exit, entries owned by static objects are freed after that
+      static thread_local ThreadCache *cache = new ThreadCache;
+      uint64_t generation = m_generation;
+      if (cache->generation!=generation) // slots of a previous generation may have been freed
+      {
+        cache->slots.clear();
+        cache->generation = generation;
+      }
+      return *cache;
+    }
+
+    bool usePool(size_t size)
+    {
+      size = roundUp(size);
+      size_t slotSize = m_slotSize;
+      if (slotSize==0) // first allocation determines the slot size
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_slotSize==0) m_slotSize = size;
+        slotSize = m_slotSize;
+      }
+      return size==slotSize;
+    }
+
+    static size_t roundUp(size_t size)
+    {
+      const size_t align = alignof(std::max_align_t);
+      return (size+align-1)/align*align;
+    }
+
+    void addBlock() // called with m_mutex locked
+    {
+      size_t slotSize = m_slotSize;
+      char *block = static_cast<char*>(malloc(slotSize*g_slotsPerBlock));
+      if (block==nullptr) throw std::bad_alloc();
+      m_blocks.push_back(block);
+      for (size_t i=0; i<g_slotsPerBlock; i++)
+      {
+        m_free.push_back(block+i*slotSize);
+      }
+    }
+
+    std::mutex m_mutex;
+    std::vector<char*> m_blocks;
+    std::vector<void*> m_free;
+    std::atomic<size_t> m_slotSize = 0;
+    std::atomic<uint64_t> m_generation = 1;
+    std::atomic<size_t> m_live = 0;
+};
+
+/** Allocator passed to std::allocate_shared by makeEntry(). */
+template<class T>
+struct EntryAllocator
+{
+  using value_type = T;
+  EntryAllocator() = default;
+  template<class U> EntryAllocator(const EntryAllocator<U> &) {}
+  T *allocate(size_t n) { return static_cast<T*>(EntryPool::instance().allocate(n*sizeof(T))); }
+  void deallocate(T *p,size_t n) { EntryPool::instance().deallocate(p,n*sizeof(T)); }
+  template<class U> bool operator==(const EntryAllocator<U> &) const { return true; }
+  template<class U> bool operator!=(const EntryAllocator<U> &) const { return false; }
+};
+
+std::shared_ptr<Entry> makeEntry()
+{
+  return std::allocate_shared<Entry>(EntryAllocator<Entry>());
+}
+
+std::shared_ptr<Entry> makeEntry(const Entry &e)
+{
+  return std::allocate_shared<Entry>(EntryAllocator<Entry>(),e);
+}
+
+bool releaseEntryPool()
+{
+  return EntryPool::instance().release();
+}
+
+//------------------------------------------------------------------
+
 static AtomicInt g_num;
 
 Entry::Entry() : section(EntryType::makeEmpty()), program(static_cast<size_t>(0)), initializer(static_cast<size_t>(0))
@@ -114,7 +284,7 @@ Entry::Entry(const Entry &e) : section(e.section)
   m_sublist.reserve(e.m_sublist.size());
   for (const auto &cur : e.m_sublist)
   {
-    m_sublist.push_back(std::make_shared<Entry>(*cur));
+    m_sublist.push_back(makeEntry(*cur));
   }
 }
 
@@ -138,7 +308,7 @@ void Entry::moveToSubEntryAndRefresh(std::shared_ptr<Entry> &current)
 {
   current->m_parent=this;
   m_sublist.push_back(current);
-  current = std::make_shared<Entry>();
+  current = makeEntry();
 }
 
 void Entry::moveToSubEntryAndKeep(Entry *current)
@@ -162,7 +332,7 @@ void Entry::copyToSubEntry(Entry *current)
 
 void Entry::copyToSubEntry(const std::shared_ptr<Entry> &current)
 {
-  std::shared_ptr<Entry> copy = std::make_shared<Entry>(*current);
+  std::shared_ptr<Entry> copy = makeEntry(*current);
   copy->m_parent=this;
   m_sublist.push_back(copy);
 }
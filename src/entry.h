@@ -268,4 +268,17 @@ class Entry
 
 typedef std::vector< std::shared_ptr<Entry> > EntryList;
 
+/** Creates a new Entry. Entries created this way are allocated from a pool,
+ *  which is released as a whole by releaseEntryPool().
+ */
+std::shared_ptr<Entry> makeEntry();
+
+/** Creates a deep copy of \a e allocated from the entry pool, see makeEntry(). */
+std::shared_ptr<Entry> makeEntry(const Entry &e);
+
+/** Returns the memory of the entry pool to the system at once, provided that no
+ *  Entry created by makeEntry() is alive anymore. Returns true if the pool was released.
+ */
+bool releaseEntryPool();
+
 #endif
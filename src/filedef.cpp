@@ -15,6 +15,7 @@
  *
  */
 
+#include <atomic>
 #include <unordered_set>
 
 #include "memberlist.h"
@@ -53,6 +54,11 @@
 
 //---------------------------------------------------------------------------
 
+//! number of bytes used by the source listings kept for the XML output, see XML_PROGRAMLISTING_MEMORY
+static std::atomic<size_t> g_recordedSourceBytes = 0;
+
+//---------------------------------------------------------------------------
+
 QCString includeStatement(SrcLangExt lang,IncludeKind kind)
 {
   bool isIDLorJava = lang==SrcLangExt::IDL || lang==SrcLangExt::Java;
@@ -177,6 +183,7 @@ class FileDefImpl : public DefinitionMixin<FileDef>
     void writeSourceBody(OutputList &ol,ClangTUParser *clangParser) override;
     void writeSourceFooter(OutputList &ol) override;
     void parseSource(ClangTUParser *clangParser) override;
+    bool replaySourceBody(OutputCodeList &ol) override;
     void setDiskName(const QCString &name) override;
     void insertMember(MemberDef *md) override;
     void removeMember(MemberDef *md) override;
@@ -246,6 +253,8 @@ class FileDefImpl : public DefinitionMixin<FileDef>
     DefinitionLineMap     m_srcDefMap;
     MemberDefLineMap      m_srcMemberMap;
     bool                  m_isSource;
+    std::unique_ptr<OutputCodeRecorder> m_recordedSource; // source code kept for the XML programlisting
+    size_t                m_recordedSourceSize = 0;
     QCString              m_fileVersion;
     DirDef               *m_dir = nullptr;
     ModuleDef            *m_moduleDef = nullptr;
@@ -1194,7 +1203,22 @@ void FileDefImpl::writeSourceBody(OutputList &ol,[[maybe_unused]] ClangTUParser
                        FALSE,QCString(),this
                       );
     }
-    intf->parseCode(codeOL,QCString(),
+    // the XML output shows the same listing, so record it once here instead of
+    // parsing the file again, provided the XML output would see the same input and
+    // links (inlined classes have different link targets in the XML output) and
+    // the memory budget for the recorded listings is not used up yet
+    size_t recordLimit = static_cast<size_t>(Config_getInt(XML_PROGRAMLISTING_MEMORY))*1024*1024;
+    bool recordForXml = Config_getBool(GENERATE_XML) && Config_getBool(XML_PROGRAMLISTING) &&
+        g_recordedSourceBytes.load()<recordLimit &&
+        !Config_getBool(INLINE_GROUPED_CLASSES) && !Config_getBool(INLINE_SIMPLE_STRUCTS) &&
+        (!filterSourceFiles || getFileFilter(absFilePath(),TRUE)==getFileFilter(absFilePath(),FALSE)) &&
+        getLanguage()==getLanguageFromFileName(getDefFileExtension());
+    OutputCodeList recordList;
+    if (recordForXml)
+    {
+      recordList.add<OutputCodeRecorder>();
+    }
+    intf->parseCode(recordForXml ? recordList : codeOL,QCString(),
         fileToString(absFilePath(),filterSourceFiles,TRUE),
         getLanguage(),      // lang
         FALSE,              // isExampleBlock
@@ -1208,6 +1232,21 @@ void FileDefImpl::writeSourceBody(OutputList &ol,[[maybe_unused]] ClangTUParser
         nullptr,                  // searchCtx
         !needs2PassParsing  // collectXRefs
         );
+    if (recordForXml)
+    {
+      OutputCodeRecorder *recorder = recordList.get<OutputCodeRecorder>(OutputType::Recorder);
+      recorder->replay(codeOL,-1,-1,TRUE);
+      size_t size = recorder->memoryUsage();
+      if (g_recordedSourceBytes.fetch_add(size)+size<=recordLimit)
+      {
+        m_recordedSource = std::make_unique<OutputCodeRecorder>(std::move(*recorder));
+        m_recordedSourceSize = size;
+      }
+      else // over budget, the XML output parses the file again
+      {
+        g_recordedSourceBytes.fetch_sub(size);
+      }
+    }
     codeOL.endCodeFragment("DoxyCode");
   }
 }
@@ -1245,6 +1284,16 @@ void FileDefImpl::parseSource([[maybe_unused]] ClangTUParser *clangParser)
   }
 }
 
+bool FileDefImpl::replaySourceBody(OutputCodeList &ol)
+{
+  if (!m_recordedSource) return FALSE;
+  m_recordedSource->replay(ol,-1,-1,TRUE);
+  m_recordedSource.reset();
+  g_recordedSourceBytes.fetch_sub(m_recordedSourceSize);
+  m_recordedSourceSize = 0;
+  return TRUE;
+}
+
 void FileDefImpl::addMembersToMemberGroup()
 {
   for (auto &ml : m_memberLists)
@@ -32,6 +32,7 @@ class ClassDef;
 class ConceptDef;
 class MemberDef;
 class OutputList;
+class OutputCodeList;
 class NamespaceDef;
 class NamespaceLinkedRefMap;
 class ConceptLinkedRefMap;
@@ -172,6 +173,10 @@ class FileDef : public DefinitionMutable, public Definition
     virtual void writeSourceBody(OutputList &ol,ClangTUParser *clangParser) = 0;
     virtual void writeSourceFooter(OutputList &ol) = 0;
     virtual void parseSource(ClangTUParser *clangParser) = 0;
+    /** Replays the code recorded by writeSourceBody() on \a ol and releases it.
+     *  Returns FALSE if nothing was recorded, then the caller has to parse the file itself.
+     */
+    virtual bool replaySourceBody(OutputCodeList &ol) = 0;
     virtual void setDiskName(const QCString &name) = 0;
 
     virtual void insertMember(MemberDef *md) = 0;
@@ -81,6 +81,13 @@ bool FileInfo::isSymLink() const
   return !ec && fs::is_symlink(std::move(status));
 }
 
+int64_t FileInfo::lastModified() const
+{
+  std::error_code ec;
+  auto time = fs::last_write_time(fs::path(m_name),ec);
+  return ec ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+}
+
 std::string FileInfo::readLink() const
 {
   std::error_code ec;
@@ -16,6 +16,7 @@
 #ifndef FILEINFO_H
 #define FILEINFO_H
 
+#include <cstdint>
 #include <string>
 
 /** @brief Minimal replacement for QFileInfo. */
@@ -32,6 +33,9 @@ class FileInfo
     bool isFile() const;
     bool isDir() const;
     bool isSymLink() const;
+    /** Returns the time of the last modification in file system specific units, or 0 on failure.
+     *  Only useful for comparing against an earlier value for the same file. */
+    int64_t lastModified() const;
     std::string readLink() const;
     std::string filePath() const;
     std::string absFilePath() const;
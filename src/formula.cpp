@@ -574,7 +574,7 @@ void FormulaManager::createFormulasTexFile(Dir &thisDir,Format format,HighDPI hd
     std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
     if (numThreads>1) // multi-threaded version
     {
-      ThreadPool threadPool(numThreads);
+      ThreadPool threadPool(numThreads,"formulas",TaskPriority::Low);
       std::vector< std::future< StringVector > > results;
       for (int pageNum : formulasToGenerate)
       {
@@ -589,7 +589,7 @@ void FormulaManager::createFormulasTexFile(Dir &thisDir,Format format,HighDPI hd
       }
       for (auto &f : results)
       {
-        auto tf = f.get();
+        auto tf = threadPool.wait(f);
         p->tempFiles.insert(p->tempFiles.end(),tf.begin(),tf.end()); // append tf to p->tempFiles
       }
     }
@@ -710,14 +710,14 @@ static void generateJSTreeFiles(NavIndexEntryList &navIndex,TextStream &t,const
   std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
   if (numThreads>1) // multi threaded version
   {
-    ThreadPool threadPool(numThreads);
+    ThreadPool threadPool(numThreads,"navtree");
     std::vector< std::future<void> > results;
     for (const auto &tf : jsTreeFiles)
     {
       results.emplace_back(threadPool.queue([&](){ generateJSFile(tf); }));
     }
     // wait for the results
-    for (auto &f : results) f.get();
+    for (auto &f : results) threadPool.wait(f);
   }
   else // single threaded version
   {
@@ -13,6 +13,8 @@
  *
  */
 
+#include <atomic>
+
 #include "htmldocvisitor.h"
 #include "docparser.h"
 #include "language.h"
@@ -629,7 +631,7 @@ void HtmlDocVisitor::operator()(const DocVerbatim &s)
 
     case DocVerbatim::Dot:
       {
-        static int dotindex = 1;
+        static std::atomic<int> dotindex = 1;
         QCString fileName(4096, QCString::ExplicitSize);
 
         forceEndParagraph(s);
@@ -663,7 +665,7 @@ void HtmlDocVisitor::operator()(const DocVerbatim &s)
       {
         forceEndParagraph(s);
 
-        static int mscindex = 1;
+        static std::atomic<int> mscindex = 1;
         QCString baseName(4096, QCString::ExplicitSize);
 
         baseName.sprintf("%s%d",
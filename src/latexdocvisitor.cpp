@@ -14,6 +14,7 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <array>
 
 #include "htmlattrib.h"
@@ -488,7 +489,7 @@ void LatexDocVisitor::operator()(const DocVerbatim &s)
       break;
     case DocVerbatim::Dot:
       {
-        static int dotindex = 1;
+        static std::atomic<int> dotindex = 1;
         QCString fileName(4096, QCString::ExplicitSize);
 
         fileName.sprintf("%s%d%s",
@@ -516,7 +517,7 @@ void LatexDocVisitor::operator()(const DocVerbatim &s)
       break;
     case DocVerbatim::Msc:
       {
-        static int mscindex = 1;
+        static std::atomic<int> mscindex = 1;
         QCString baseName(4096, QCString::ExplicitSize);
 
         baseName.sprintf("%s%d",
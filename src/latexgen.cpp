@@ -290,6 +290,7 @@ LatexGenerator::LatexGenerator(const LatexGenerator &og) : OutputGenerator(og.m_
   m_relPath            = og.m_relPath;
   m_indent             = og.m_indent;
   m_templateMemberItem = og.m_templateMemberItem;
+  m_insideTableEnv     = og.m_insideTableEnv;
   m_hierarchyLevel     = og.m_hierarchyLevel;
 }
 
@@ -306,6 +307,7 @@ LatexGenerator &LatexGenerator::operator=(const LatexGenerator &og)
     m_relPath            = og.m_relPath;
     m_indent             = og.m_indent;
     m_templateMemberItem = og.m_templateMemberItem;
+    m_insideTableEnv     = og.m_insideTableEnv;
     m_hierarchyLevel     = og.m_hierarchyLevel;
   }
   return *this;
@@ -24,6 +24,31 @@
 #include <cctype>
 
 #include "qcstring.h"
+#include "atom.h"
+
+//! @brief Converts the keys passed to a LinkedMap or LinkedRefMap into the key type of its lookup map.
+//! @details The primary template handles maps keyed by std::string.
+template<class Key>
+struct LinkedMapKey
+{
+  //! Returns the map key used to look up \a key.
+  static const std::string &lookup(const std::string &key) { return key; }
+  static const std::string &lookup(const QCString &key)    { return key.str(); }
+  //! Returns the map key used to store an object under \a key.
+  static const std::string &store(const std::string &key)  { return key; }
+  static const std::string &store(const QCString &key)     { return key.str(); }
+};
+
+//! @brief Key conversion for maps keyed by Atom.
+//! @details Looking up a key never adds it to the string table.
+template<>
+struct LinkedMapKey<Atom>
+{
+  static Atom lookup(const std::string &key) { return Atom::find(key); }
+  static Atom lookup(const QCString &key)    { return Atom::find(key); }
+  static Atom store(const std::string &key)  { return Atom(key); }
+  static Atom store(const QCString &key)     { return Atom(key); }
+};
 
 //! @brief Container class representing a vector of objects with keys.
 //! @details Objects can efficiently be looked up given the key.
@@ -41,12 +66,13 @@ class LinkedMap
     using const_iterator = typename Vec::const_iterator;
     using reverse_iterator = typename Vec::reverse_iterator;
     using const_reverse_iterator = typename Vec::const_reverse_iterator;
+    using KeyConv = LinkedMapKey<typename Map::key_type>;
 
     //! Find an object given the key.
     //! Returns a pointer to the element if found or nullptr if it is not found.
     const T *find(const std::string &key) const
     {
-      auto it = m_lookup.find(key);
+      auto it = m_lookup.find(KeyConv::lookup(key));
       return it!=m_lookup.end() ? it->second : nullptr;
     }
 
@@ -54,7 +80,7 @@ class LinkedMap
     //! Returns a pointer to the element if found or nullptr if it is not found.
     const T *find(const QCString &key) const
     {
-      auto it = m_lookup.find(key.str());
+      auto it = m_lookup.find(KeyConv::lookup(key));
       return it!=m_lookup.end() ? it->second : nullptr;
     }
 
@@ -95,7 +121,7 @@ class LinkedMap
         std::string key(k ? k : "");
         Ptr ptr = std::make_unique<T>(QCString(k),std::forward<Args>(args)...);
         result = ptr.get();
-        m_lookup.emplace(key,result);
+        m_lookup.emplace(KeyConv::store(key),result);
         m_entries.push_back(std::move(ptr));
       }
       return result;
@@ -110,7 +136,7 @@ class LinkedMap
       {
         Ptr ptr = std::make_unique<T>(k,std::forward<Args>(args)...);
         result = ptr.get();
-        m_lookup.emplace(key,result);
+        m_lookup.emplace(KeyConv::store(key),result);
         m_entries.push_back(std::move(ptr));
       }
       return result;
@@ -127,7 +153,7 @@ class LinkedMap
       {
         std::string key(k ? k : "");
         result = ptr.get();
-        m_lookup.emplace(key,result);
+        m_lookup.emplace(KeyConv::store(key),result);
         m_entries.push_back(std::move(ptr));
       }
       return result;
@@ -140,7 +166,7 @@ class LinkedMap
       if (result==nullptr)
       {
         result = ptr.get();
-        m_lookup.emplace(key,result);
+        m_lookup.emplace(KeyConv::store(key),result);
         m_entries.push_back(std::move(ptr));
       }
       return result;
@@ -158,7 +184,7 @@ class LinkedMap
         std::string key(k ? k : "");
         Ptr ptr = std::make_unique<T>(key.c_str(),std::forward<Args>(args)...);
         result = ptr.get();
-        m_lookup.emplace(key,result);
+        m_lookup.emplace(KeyConv::store(key),result);
         m_entries.push_front(std::move(ptr));
       }
       return result;
@@ -172,7 +198,7 @@ class LinkedMap
       {
         Ptr ptr = std::make_unique<T>(key,std::forward<Args>(args)...);
         result = ptr.get();
-        m_lookup.emplace(key.str(),result);
+        m_lookup.emplace(KeyConv::store(key),result);
         m_entries.push_front(std::move(ptr));
       }
       return result;
@@ -182,7 +208,7 @@ class LinkedMap
     //! Returns true if the object was deleted or false it is was not found.
     bool del(const QCString &key)
     {
-      auto it = m_lookup.find(key.str());
+      auto it = m_lookup.find(KeyConv::lookup(key));
       if (it!=m_lookup.end())
       {
         auto vecit = std::find_if(m_entries.begin(),m_entries.end(),[obj=it->second](auto &el) { return el.get()==obj; });
@@ -237,12 +263,13 @@ class LinkedRefMap
     using const_iterator = typename Vec::const_iterator;
     using reverse_iterator = typename Vec::reverse_iterator;
     using const_reverse_iterator = typename Vec::const_reverse_iterator;
+    using KeyConv = LinkedMapKey<typename Map::key_type>;
 
     //! find an object given the key.
     //! Returns a pointer to the object if found or nullptr if it is not found.
     const T *find(const std::string &key) const
     {
-      auto it = m_lookup.find(key);
+      auto it = m_lookup.find(KeyConv::lookup(key));
       return it!=m_lookup.end() ? it->second : nullptr;
     }
 
@@ -250,7 +277,7 @@ class LinkedRefMap
     //! Returns a pointer to the object if found or nullptr if it is not found.
     const T *find(const QCString &key) const
     {
-      auto it = m_lookup.find(key.str());
+      auto it = m_lookup.find(KeyConv::lookup(key));
       return it!=m_lookup.end() ? it->second : nullptr;
     }
 
@@ -286,7 +313,7 @@ class LinkedRefMap
       if (find(k)==nullptr) // new element
       {
         std::string key(k ? k : "");
-        m_lookup.emplace(key,obj);
+        m_lookup.emplace(KeyConv::store(key),obj);
         m_entries.push_back(obj);
         return true;
       }
@@ -301,7 +328,7 @@ class LinkedRefMap
       std::string key = k.str();
       if (find(key)==nullptr) // new element
       {
-        m_lookup.emplace(key,obj);
+        m_lookup.emplace(KeyConv::store(key),obj);
         m_entries.push_back(obj);
         return true;
       }
@@ -319,7 +346,7 @@ class LinkedRefMap
       if (find(k)==nullptr) // new element
       {
         std::string key(k ? k : "");
-        m_lookup.emplace(key,obj);
+        m_lookup.emplace(KeyConv::store(key),obj);
         m_entries.insert(m_entries.begin(),obj);
         return true;
       }
@@ -333,7 +360,7 @@ class LinkedRefMap
     {
       if (find(key)==nullptr) // new element
       {
-        m_lookup.emplace(key.str(),obj);
+        m_lookup.emplace(KeyConv::store(key),obj);
         m_entries.insert(m_entries.begin(),obj);
         return true;
       }
@@ -347,7 +374,7 @@ class LinkedRefMap
     //! Returns true if the object was deleted or false it is was not found.
     bool del(const QCString &key)
     {
-      auto it = m_lookup.find(key.str());
+      auto it = m_lookup.find(KeyConv::lookup(key));
       if (it!=m_lookup.end())
       {
         auto vecit = std::find_if(m_entries.begin(),m_entries.end(),[obj=it->second](auto &el) { return el.get()==obj; });
@@ -385,5 +412,8 @@ class LinkedRefMap
     Vec m_entries;
 };
 
+//! @brief LinkedMap that stores its keys as atoms, so lookups hash and compare small integers.
+template<class T>
+using AtomLinkedMap = LinkedMap<T,std::hash<Atom>,std::equal_to<Atom>,std::unordered_map<Atom,T*>>;
 
 #endif
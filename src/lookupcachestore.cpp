@@ -0,0 +1,318 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+
+#include "lookupcachestore.h"
+#include "doxygen.h"
+#include "config.h"
+#include "definition.h"
+#include "memberdef.h"
+#include "filedef.h"
+#include "namespacedef.h"
+#include "filename.h"
+#include "fileinfo.h"
+#include "symbolmap.h"
+#include "serialization.h"
+#include "parsecache.h"
+#include "portable.h"
+#include "message.h"
+#include "md5.h"
+#include "util.h"
+
+// bump this whenever the layout of the file changes
+static const uint32_t g_formatVersion = 2;
+static const char    *g_magic         = "DOXYGEN_LOOKUP_CACHE";
+
+//! Size and modification time of the files the stored entries depend on.
+struct FileStamp
+{
+  std::string name;
+  uint64_t    size = 0;
+  uint64_t    lastModified = 0;
+};
+
+static FileStamp fileStamp(const std::string &fileName)
+{
+  FileInfo fi(fileName);
+  return FileStamp{ fileName, fi.size(), static_cast<uint64_t>(fi.lastModified()) };
+}
+
+//! The inputs a single lookup result depends on: the files defining the symbols that
+//! were candidates for the lookup, the result and its scopes, the scope the lookup was
+//! done in and the file whose using statements were taken into account, together with
+//! a digest of the candidate symbols, which also changes when a symbol with the same
+//! name is added or removed in another file.
+struct EntryDependencies
+{
+  std::string candidates;
+  StringSet   files;
+};
+
+static void addScopeFiles(StringSet &files,const Definition *d)
+{
+  while (d && d!=Doxygen::globalScope)
+  {
+    files.insert(d->getDefFileName().str());
+    d = d->getOuterScope();
+  }
+}
+
+static EntryDependencies computeDependencies(const std::string &key,const Definition *definition,const MemberDef *typeDef)
+{
+  EntryDependencies deps;
+  StringSet names;
+  if (definition) names.insert(definition->symbolName().str());
+  if (typeDef)    names.insert(typeDef->symbolName().str());
+  StringVector lines;
+  for (const auto &name : names)
+  {
+    for (const Definition *d : Doxygen::symbolMap->find(QCString(name)))
+    {
+      lines.push_back(name+'\t'+std::to_string(d->definitionType())+'\t'+d->qualifiedName().str()+'\t'+
+                      d->getDefFileName().str()+'\t'+std::to_string(d->getDefLine()));
+      addScopeFiles(deps.files,d);
+    }
+    // the key starts with the name of the scope in which the lookup was done
+    size_t i = key.find('+'+name+'+');
+    if (i!=std::string::npos && i>0)
+    {
+      std::string scopeName = key.substr(0,i);
+      size_t j = scopeName.rfind("::");
+      for (const Definition *d : Doxygen::symbolMap->find(QCString(j==std::string::npos ? scopeName : scopeName.substr(j+2))))
+      {
+        if (d->qualifiedName()==scopeName.c_str()) addScopeFiles(deps.files,d);
+      }
+    }
+  }
+  addScopeFiles(deps.files,definition);
+  addScopeFiles(deps.files,typeDef);
+  // a lookup from a file with using statements has the path of that file in its key
+  for (const auto &part : split(key,"+"))
+  {
+    if (Portable::isAbsolutePath(part.c_str()) && FileInfo(part).isFile()) deps.files.insert(part);
+  }
+  std::sort(lines.begin(),lines.end());
+  std::string text;
+  for (const auto &line : lines)
+  {
+    text+=line;
+    text+='\n';
+  }
+  uint8_t md5_sig[16];
+  char sigStr[33];
+  MD5Buffer(text.data(),static_cast<unsigned int>(text.size()),md5_sig);
+  MD5SigToString(md5_sig,sigStr);
+  deps.candidates = sigStr;
+  return deps;
+}
+
+static void writeDefinition(Serializer &s,const Definition *d)
+{
+  s.writeBool(d!=nullptr);
+  if (d==nullptr) return;
+  const Definition *scope = d->getOuterScope();
+  s.writeEnum(d->definitionType());
+  s.writeBool(d->isAlias());
+  s.writeString(d->symbolName());
+  s.writeString(d->qualifiedName());
+  s.writeString(scope ? scope->qualifiedName() : QCString());
+  s.writeString(d->getDefFileName());
+  s.writeInt(d->getDefLine());
+  s.writeString(d->definitionType()==Definition::TypeMember ? d->anchor() : QCString());
+}
+
+//! Reads a definition written by writeDefinition() and looks it up in the symbol map.
+//! Returns FALSE if the definition was stored but could not be found unambiguously.
+static bool readDefinition(Deserializer &s,const Definition *&result)
+{
+  result = nullptr;
+  if (!s.readBool()) return true;
+  auto     type          = s.readEnum<Definition::DefType>();
+  bool     isAlias       = s.readBool();
+  QCString symbolName    = s.readQCString();
+  QCString qualifiedName = s.readQCString();
+  QCString scopeName     = s.readQCString();
+  QCString fileName      = s.readQCString();
+  int      line          = s.readInt();
+  QCString anchor        = s.readQCString();
+  if (s.failed()) return false;
+
+  int count=0;
+  for (const Definition *d : Doxygen::symbolMap->find(symbolName))
+  {
+    const Definition *scope = d->getOuterScope();
+    if (d->definitionType()==type &&
+        d->isAlias()==isAlias &&
+        d->getDefLine()==line &&
+        d->qualifiedName()==qualifiedName &&
+        d->getDefFileName()==fileName &&
+        (scope ? scope->qualifiedName() : QCString())==scopeName &&
+        (type!=Definition::TypeMember || d->anchor()==anchor))
+    {
+      result = d;
+      count++;
+    }
+  }
+  return count==1;
+}
+
+//! Files the stored entries depend on, entries refer to them by index.
+struct FileTable
+{
+  std::unordered_map<std::string,uint32_t> index;
+  std::vector<FileStamp> stamps;
+
+  uint32_t add(const std::string &fileName)
+  {
+    auto it = index.find(fileName);
+    if (it==index.end())
+    {
+      it = index.emplace(fileName,static_cast<uint32_t>(stamps.size())).first;
+      stamps.push_back(fileStamp(fileName));
+    }
+    return it->second;
+  }
+};
+
+//! Writes the entries of \a cache that can be validated by a later run, each with its
+//! dependencies, to a separate block, since the file table is written in front of it.
+static std::string writeCache(const ConcurrentCache<LookupInfo> &cache,FileTable &fileTable)
+{
+  size_t count=0;
+  Serializer s;
+  cache.forEach([&](const std::string &key,const LookupInfo &li)
+  {
+    // a failed lookup depends on all symbols that could have matched, so it cannot be validated
+    if (li.definition==nullptr && li.typeDef==nullptr) return;
+    EntryDependencies deps = computeDependencies(key,li.definition,li.typeDef);
+    s.writeString(key);
+    writeDefinition(s,li.definition);
+    writeDefinition(s,li.typeDef);
+    s.writeString(li.templSpec);
+    s.writeString(li.resolvedType);
+    s.writeString(deps.candidates);
+    s.writeSize(deps.files.size());
+    for (const auto &fileName : deps.files)
+    {
+      s.writeUInt(fileTable.add(fileName));
+    }
+    count++;
+  });
+  Serializer result;
+  result.writeSize(count);
+  return result.data()+s.data();
+}
+
+//! Reads the entries written by writeCache() into \a cache and returns the number of entries added.
+//! An entry is only added if the files it depends on did not change (\a changed) and the
+//! symbols that were candidates for the lookup are still the same.
+static size_t readCache(Deserializer &s,ConcurrentCache<LookupInfo> &cache,const std::vector<bool> &changed)
+{
+  size_t added=0;
+  size_t count = s.readSize();
+  for (size_t i=0; i<count && !s.failed(); i++)
+  {
+    std::string key = s.readString();
+    const Definition *definition = nullptr;
+    const Definition *typeDef = nullptr;
+    bool found = readDefinition(s,definition);
+    found = readDefinition(s,typeDef) && found;
+    QCString templSpec    = s.readQCString();
+    QCString resolvedType = s.readQCString();
+    std::string candidates = s.readString();
+    bool unchanged = true;
+    size_t numFiles = s.readSize();
+    for (size_t j=0; j<numFiles && !s.failed(); j++)
+    {
+      uint32_t index = s.readUInt();
+      unchanged = unchanged && index<changed.size() && !changed[index];
+    }
+    if (found && unchanged && !s.failed() && (typeDef==nullptr || toMemberDef(typeDef)) &&
+        computeDependencies(key,definition,toMemberDef(typeDef)).candidates==candidates &&
+        cache.insertIfAbsent(key,LookupInfo(definition,toMemberDef(typeDef),templSpec,resolvedType)))
+    {
+      added++;
+    }
+  }
+  return added;
+}
+
+void loadLookupCaches()
+{
+  QCString fileName = Config_getString(LOOKUP_CACHE_FILE);
+  if (fileName.isEmpty()) return;
+  std::ifstream f = Portable::openInputStream(fileName,true);
+  if (!f.is_open()) return;
+  std::string data((std::istreambuf_iterator<char>(f)),std::istreambuf_iterator<char>());
+
+  Deserializer s(data);
+  if (s.readString()!=g_magic ||
+      s.readUInt()!=g_formatVersion ||
+      s.readString()!=ParseCache::configFingerprint())
+  {
+    msg("Lookup cache file %s was written with a different configuration, not using it\n",qPrint(fileName));
+    return;
+  }
+  size_t numFiles = s.readSize();
+  std::vector<bool> changed;
+  for (size_t i=0; i<numFiles && !s.failed(); i++)
+  {
+    FileStamp stamp;
+    stamp.name         = s.readString();
+    stamp.size         = s.readUInt64();
+    stamp.lastModified = s.readUInt64();
+    FileStamp current = fileStamp(stamp.name);
+    changed.push_back(current.size!=stamp.size || current.lastModified!=stamp.lastModified);
+  }
+  size_t types   = readCache(s,*Doxygen::typeLookupCache,changed);
+  size_t symbols = readCache(s,*Doxygen::symbolLookupCache,changed);
+  msg("Preloaded %zu type lookups and %zu symbol lookups from %s\n",types,symbols,qPrint(fileName));
+}
+
+void saveLookupCaches()
+{
+  QCString fileName = Config_getString(LOOKUP_CACHE_FILE);
+  if (fileName.isEmpty()) return;
+  FileTable fileTable;
+  std::string types   = writeCache(*Doxygen::typeLookupCache,fileTable);
+  std::string symbols = writeCache(*Doxygen::symbolLookupCache,fileTable);
+
+  Serializer s;
+  s.writeString(std::string(g_magic));
+  s.writeUInt(g_formatVersion);
+  s.writeString(ParseCache::configFingerprint());
+  s.writeSize(fileTable.stamps.size());
+  for (const auto &stamp : fileTable.stamps)
+  {
+    s.writeString(stamp.name);
+    s.writeUInt64(stamp.size);
+    s.writeUInt64(stamp.lastModified);
+  }
+
+  std::ofstream f = Portable::openOutputStream(fileName);
+  if (f.is_open())
+  {
+    f.write(s.data().data(),static_cast<std::streamsize>(s.data().size()));
+    f.write(types.data(),static_cast<std::streamsize>(types.size()));
+    f.write(symbols.data(),static_cast<std::streamsize>(symbols.size()));
+  }
+  if (!f.good())
+  {
+    warn_uncond("failed to write lookup cache file %s\n",qPrint(fileName));
+  }
+}
@@ -0,0 +1,41 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef LOOKUPCACHESTORE_H
+#define LOOKUPCACHESTORE_H
+
+/** @file
+ *  @brief Persistence of the type and symbol lookup caches between runs.
+ *
+ *  When \c LOOKUP_CACHE_FILE is set, the resolved entries of Doxygen::typeLookupCache
+ *  and Doxygen::symbolLookupCache are written to that file at the end of a run. The
+ *  definitions an entry refers to are stored by name, kind, and location instead of
+ *  by pointer. Each entry also records the files it depends on and a digest of the
+ *  symbols that were candidates for the lookup, so after an edit only the entries
+ *  that may be affected are dropped. Failed lookups are not stored, since they
+ *  depend on every symbol that could have matched.
+ *
+ *  The entries are preloaded when output generation starts. The lookups done while
+ *  the input is processed see an incomplete symbol table and are computed as before,
+ *  so results of the end of a run do not leak into an earlier phase.
+ */
+
+/** Preloads the lookup caches from the file written by an earlier run. */
+void loadLookupCaches();
+
+/** Writes the contents of the lookup caches to a file for use by a later run. */
+void saveLookupCaches();
+
+#endif
@@ -18,6 +18,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <mutex>
 
 #include "message.h"
 #include "mangen.h"
@@ -33,6 +34,8 @@
 #include "portable.h"
 #include "outputlist.h"
 
+static std::mutex g_linkFileMutex;
+
 static QCString getExtension()
 {
   /*
@@ -514,6 +517,8 @@ void ManGenerator::startDoxyAnchor(const QCString &,const QCString &manName,
 
     // - remove dangerous characters and append suffix, then add dir prefix
     QCString fileName=dir()+"/"+buildFileName( baseName );
+    // the first anchor with a given name owns the link file, also when generating in parallel
+    std::lock_guard<std::mutex> lock(g_linkFileMutex);
     FileInfo fi(fileName.str());
     if (!fi.exists())
     {
@@ -53,6 +53,7 @@
 #include "trace.h"
 #include "anchor.h"
 #include "stringutil.h"
+#include "parsecache.h"
 
 #if !ENABLE_MARKDOWN_TRACING
 #undef  AUTO_TRACE
@@ -1466,6 +1467,7 @@ int Markdown::Private::processLink(const std::string_view data,size_t offset)
   {
     bool ambig = false;
     FileDef *fd=nullptr;
+    ParseCache::markUncacheable(); // result depends on the available image files
     if (link.find("@ref ")!=-1 || link.find("\\ref ")!=-1 ||
         (fd=findFileDef(Doxygen::imageNameLinkedMap,link,ambig)))
         // assume doxygen symbol link or local image link
@@ -3564,7 +3566,7 @@ void MarkdownOutlineParser::parseInput(const QCString &fileName,
                 const std::shared_ptr<Entry> &root,
                 ClangTUParser* /*clangParser*/)
 {
-  std::shared_ptr<Entry> current = std::make_shared<Entry>();
+  std::shared_ptr<Entry> current = makeEntry();
   int prepend = 0; // number of empty lines in front
   current->lang = SrcLangExt::Markdown;
   current->fileName = fileName;
@@ -59,7 +59,7 @@ class MemberName
 };
 
 /** Ordered dictionary of MemberName objects. */
-class MemberNameLinkedMap : public LinkedMap<MemberName>
+class MemberNameLinkedMap : public AtomLinkedMap<MemberName>
 {
   public:
     MemberName::Ptr take(const QCString &key,const MemberDef *value)
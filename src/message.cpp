@@ -25,6 +25,7 @@
 #include "doxygen.h"
 #include "fileinfo.h"
 #include "dir.h"
+#include "threadpool.h"
 
 // globals
 static QCString        g_warnFormat;
@@ -37,6 +38,12 @@ static QCString        g_warnlogFile;
 static bool            g_warnlogTemp = false;
 static std::atomic_bool g_warnStat = false;
 static std::mutex      g_mutex;
+static thread_local size_t g_warnCountForThread = 0;
+static ThreadStateRegistration g_warnCountState([]()
+{
+  size_t count = g_warnCountForThread;
+  return std::function<void()>([count]() { g_warnCountForThread = count; });
+});
 
 void initWarningFormat()
 {
@@ -152,6 +159,7 @@ static void format_warn(const QCString &file,int line,const QCString &text)
     exit(1);
   }
   g_warnStat = true;
+  g_warnCountForThread++;
 }
 
 static void handle_warn_as_error()
@@ -171,6 +179,7 @@ static void handle_warn_as_error()
     exit(1);
   }
   g_warnStat = true;
+  g_warnCountForThread++;
 }
 
 static void do_warn(bool enabled, const QCString &file, int line, const char *prefix, const char *fmt, va_list args)
@@ -300,6 +309,11 @@ void term_(const char *fmt, ...)
   exit(1);
 }
 
+size_t warnCountForCurrentThread()
+{
+  return g_warnCountForThread;
+}
+
 void warn_flush()
 {
   fflush(g_warnFile);
@@ -39,6 +39,8 @@ extern void term_(const char *fmt, ...) PRINTFLIKE(1, 2);
 extern QCString warn_line(const QCString &file,int line);
 void initWarningFormat();
 void warn_flush();
+//! Returns the number of warnings issued so far by the calling thread.
+size_t warnCountForCurrentThread();
 extern void finishWarnExit();
 
 #undef PRINTFLIKE
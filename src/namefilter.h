@@ -0,0 +1,77 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef NAMEFILTER_H
+#define NAMEFILTER_H
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+/** @brief Compact, immutable set of names, used to quickly reject strings that are not one of them.
+ *
+ *  Only a 64 bit hash is stored per name, in an open addressing table that is
+ *  at most half full, so a lookup is a single hash computation and usually one
+ *  or two probes. contains() never returns FALSE for a name that was added,
+ *  but may return TRUE for another string whose hash happens to be the same.
+ */
+class NameFilter
+{
+  public:
+    NameFilter() = default;
+
+    /** Creates a filter containing \a names. */
+    explicit NameFilter(const std::vector<std::string_view> &names)
+    {
+      size_t size = 16;
+      while (size<names.size()*2) size*=2;
+      m_table.resize(size,0);
+      m_mask = size-1;
+      for (const auto &name : names)
+      {
+        uint64_t h = hash(name);
+        size_t i = static_cast<size_t>(h) & m_mask;
+        while (m_table[i]!=0 && m_table[i]!=h) i = (i+1) & m_mask;
+        m_table[i] = h;
+      }
+    }
+
+    /** Returns FALSE if \a name is certainly not in the set. */
+    bool contains(std::string_view name) const
+    {
+      if (m_table.empty()) return false;
+      uint64_t h = hash(name);
+      for (size_t i = static_cast<size_t>(h) & m_mask; m_table[i]!=0; i = (i+1) & m_mask)
+      {
+        if (m_table[i]==h) return true;
+      }
+      return false;
+    }
+
+    bool isEmpty() const { return m_table.empty(); }
+
+  private:
+    static uint64_t hash(std::string_view name)
+    {
+      uint64_t h = std::hash<std::string_view>()(name);
+      return h!=0 ? h : 1; // 0 marks an empty slot
+    }
+
+    std::vector<uint64_t> m_table;
+    size_t m_mask = 0;
+};
+
+#endif
@@ -180,9 +180,8 @@ void OutputList::generateDoc(const QCString &fileName,int startLine,
   // specified as:
   // - when only XML format there should be warnings as well (XML has its own write routines)
   // - no formats there should be warnings as well
-  auto parser { createDocParser() };
-  auto ast    { validatingParseDoc(*parser.get(),
-                                   fileName,startLine,
+  // a block that was already parsed for another page is not validated again.
+  auto ast    { DocAstCache::instance().parse(fileName,startLine,
                                    ctx,md,docStr,indexWords,isExample,exampleName,
                                    singleLine,linkFromIndex,markdownSupport) };
   if (ast && count>0) writeDoc(ast.get(),ctx,md);
@@ -227,11 +226,28 @@ void OutputCodeRecorder::startNewLine(int lineNr)
   }
 }
 
+// the string arguments of a call must be added directly after the call itself
+void OutputCodeRecorder::addCall(Op op,int value,bool flag)
+{
+  m_calls.push_back(Call{op,flag,value,static_cast<uint32_t>(m_args.size())});
+}
+
+void OutputCodeRecorder::addString(const QCString &s)
+{
+  m_args.push_back(StringRef{static_cast<uint32_t>(m_text.size()),static_cast<uint32_t>(s.length())});
+  m_text.append(s.data(),s.length());
+}
+
+QCString OutputCodeRecorder::getString(uint32_t index) const
+{
+  const StringRef &s = m_args[index];
+  return QCString(std::string_view(m_text).substr(s.offset,s.length));
+}
+
 void OutputCodeRecorder::codify(const QCString &s)
 {
-  m_calls.emplace_back([]() { return true; },
-                       [=](OutputCodeList *ol) { ol->codify(s); }
-                      );
+  addCall(Op::Codify);
+  addString(s);
 }
 
 void OutputCodeRecorder::writeCodeLink(CodeSymbolType type,
@@ -239,62 +255,57 @@ void OutputCodeRecorder::writeCodeLink(CodeSymbolType type,
                    const QCString &anchor,const QCString &name,
                    const QCString &tooltip)
 {
-  m_calls.emplace_back([](){ return true; },
-                       [=](OutputCodeList *ol) { ol->writeCodeLink(type,ref,file,anchor,name,tooltip); }
-                      );
+  addCall(Op::CodeLink,static_cast<int>(type));
+  addString(ref);
+  addString(file);
+  addString(anchor);
+  addString(name);
+  addString(tooltip);
 }
 
 void OutputCodeRecorder::writeLineNumber(const QCString &ref,const QCString &file,const QCString &anchor,
                      int lineNumber, bool writeLineAnchor)
 {
   startNewLine(lineNumber);
-  m_calls.emplace_back([&]() { return m_showLineNumbers; },
-                       [=](OutputCodeList *ol) { ol->writeLineNumber(ref,file,anchor,lineNumber,writeLineAnchor); }
-                      );
+  addCall(Op::LineNumber,lineNumber,writeLineAnchor);
+  addString(ref);
+  addString(file);
+  addString(anchor);
 }
 
 void OutputCodeRecorder::writeTooltip(const QCString &id, const DocLinkInfo &docInfo, const QCString &decl,
                   const QCString &desc, const SourceLinkInfo &defInfo, const SourceLinkInfo &declInfo)
 {
-  m_calls.emplace_back([](){ return true; },
-                       [=](OutputCodeList *ol) { ol->writeTooltip(id,docInfo,decl,desc,defInfo,declInfo); }
-                      );
+  m_calls.push_back(Call{Op::Tooltip,false,0,static_cast<uint32_t>(m_tooltips.size())});
+  m_tooltips.push_back(TooltipInfo{id,docInfo,decl,desc,defInfo,declInfo});
 }
 
 void OutputCodeRecorder::startCodeLine(int lineNr)
 {
   startNewLine(lineNr);
-  m_calls.emplace_back([](){ return true; },
-                       [=](OutputCodeList *ol) { ol->startCodeLine(lineNr); }
-                      );
+  addCall(Op::StartCodeLine,lineNr);
 }
 
 void OutputCodeRecorder::endCodeLine()
 {
-  m_calls.emplace_back([](){ return true; },
-                       [=](OutputCodeList *ol) { ol->endCodeLine(); }
-                      );
+  addCall(Op::EndCodeLine);
 }
 
 void OutputCodeRecorder::startFontClass(const QCString &c)
 {
-  m_calls.emplace_back([]() { return true; },
-                       [=](OutputCodeList *ol) { ol->startFontClass(c); }
-                      );
+  addCall(Op::StartFontClass);
+  addString(c);
 }
 
 void OutputCodeRecorder::endFontClass()
 {
-  m_calls.emplace_back([]() { return true; },
-                       [=](OutputCodeList *ol){ ol->endFontClass(); }
-                      );
+  addCall(Op::EndFontClass);
 }
 
 void OutputCodeRecorder::writeCodeAnchor(const QCString &name)
 {
-  m_calls.emplace_back([]() { return true; },
-                       [=](OutputCodeList *ol){ ol->writeCodeAnchor(name); }
-                      );
+  addCall(Op::CodeAnchor);
+  addString(name);
 }
 
 void OutputCodeRecorder::startCodeFragment(const QCString &style)
@@ -307,26 +318,78 @@ void OutputCodeRecorder::endCodeFragment(const QCString &style)
 
 void OutputCodeRecorder::startFold(int lineNr,const QCString &startMarker,const QCString &endMarker)
 {
-  m_calls.emplace_back([]() { return true; },
-                       [=](OutputCodeList *ol) { ol->startFold(lineNr,startMarker,endMarker); }
-                      );
+  addCall(Op::StartFold,lineNr);
+  addString(startMarker);
+  addString(endMarker);
 }
 
 void OutputCodeRecorder::endFold()
 {
-  m_calls.emplace_back([]() { return true; },
-                       [=](OutputCodeList *ol) { ol->endFold(); }
-                      );
+  addCall(Op::EndFold);
+}
+
+size_t OutputCodeRecorder::memoryUsage() const
+{
+  size_t size = m_calls.capacity()*sizeof(Call)+m_args.capacity()*sizeof(StringRef)+m_text.capacity()+
+                m_tooltips.capacity()*sizeof(TooltipInfo)+m_lineOffset.capacity()*sizeof(size_t);
+  for (const auto &ti : m_tooltips)
+  {
+    size+=ti.id.length()+ti.decl.length()+ti.desc.length();
+  }
+  return size;
 }
 
-void OutputCodeRecorder::replay(OutputCodeList &ol,int startLine,int endLine,bool showLineNumbers)
+void OutputCodeRecorder::replay(OutputCodeList &ol,int startLine,int endLine,bool showLineNumbers) const
 {
   size_t startIndex = startLine>0 && startLine<=(int)m_lineOffset.size() ? m_lineOffset[startLine-1] : 0;
   size_t endIndex   = endLine>0   && endLine  <=(int)m_lineOffset.size() ? m_lineOffset[  endLine-1] : m_calls.size();
   //printf("startIndex=%zu endIndex=%zu\n",startIndex,endIndex);
-  m_showLineNumbers = showLineNumbers;
   for (size_t i=startIndex; i<endIndex; i++)
   {
-    if (m_calls[i].condition()) m_calls[i].function(&ol);
+    const Call &call = m_calls[i];
+    uint32_t a = call.arg;
+    switch (call.op)
+    {
+      case Op::Codify:
+        ol.codify(getString(a));
+        break;
+      case Op::CodeLink:
+        ol.writeCodeLink(static_cast<CodeSymbolType>(call.value),
+                         getString(a),getString(a+1),getString(a+2),getString(a+3),getString(a+4));
+        break;
+      case Op::LineNumber:
+        if (showLineNumbers)
+        {
+          ol.writeLineNumber(getString(a),getString(a+1),getString(a+2),call.value,call.flag);
+        }
+        break;
+      case Op::Tooltip:
+        {
+          const TooltipInfo &t = m_tooltips[a];
+          ol.writeTooltip(t.id,t.docInfo,t.decl,t.desc,t.defInfo,t.declInfo);
+        }
+        break;
+      case Op::StartCodeLine:
+        ol.startCodeLine(call.value);
+        break;
+      case Op::EndCodeLine:
+        ol.endCodeLine();
+        break;
+      case Op::StartFontClass:
+        ol.startFontClass(getString(a));
+        break;
+      case Op::EndFontClass:
+        ol.endFontClass();
+        break;
+      case Op::CodeAnchor:
+        ol.writeCodeAnchor(getString(a));
+        break;
+      case Op::StartFold:
+        ol.startFold(call.value,getString(a),getString(a+1));
+        break;
+      case Op::EndFold:
+        ol.endFold();
+        break;
+    }
   }
 }
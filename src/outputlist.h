@@ -103,6 +103,9 @@ using OutputCodeDeferExtension  = OutputCodeDefer<OutputCodeIntf>;
 
 /** Implementation that allows capturing calls made to the code interface to later
  *  invoke them on a #OutputCodeList via replay().
+ *
+ *  The calls are stored compactly: one small record per call, with all string
+ *  arguments appended to a single text buffer.
  */
 class OutputCodeRecorder : public OutputCodeIntf
 {
@@ -128,20 +131,50 @@ class OutputCodeRecorder : public OutputCodeIntf
     void startFold(int lineNr,const QCString &startMarker,const QCString &endMarker) override;
     void endFold() override;
 
-    void replay(OutputCodeList &ol,int startLine,int endLine,bool showLineNumbers);
+    /** Replays the recorded calls for lines \a startLine up to \a endLine on \a ol.
+     *  A line number that is not positive or beyond the last line means the start or end
+     *  of the recording. Line numbers are only written if \a showLineNumbers is TRUE.
+     */
+    void replay(OutputCodeList &ol,int startLine,int endLine,bool showLineNumbers) const;
+
+    /** Returns the approximate number of bytes used by the recorded calls. */
+    size_t memoryUsage() const;
   private:
-    void startNewLine(int lineNr);
-    struct CallInfo
+    enum class Op : uint8_t
+    {
+      Codify, CodeLink, LineNumber, Tooltip, StartCodeLine, EndCodeLine,
+      StartFontClass, EndFontClass, CodeAnchor, StartFold, EndFold
+    };
+    struct Call
     {
-      using ConditionFunc = std::function<bool()>;
-      using OutputFunc    = std::function<void(OutputCodeList*)>;
-      CallInfo(ConditionFunc &&c,OutputFunc &&f) : condition(std::move(c)), function(std::move(f)) {}
-      ConditionFunc  condition;
-      OutputFunc     function;
+      Op       op;
+      bool     flag;  // writeLineAnchor for LineNumber
+      int      value; // line number, or symbol type for CodeLink
+      uint32_t arg;   // index of the first string argument in m_args, or of the tooltip in m_tooltips
     };
-    std::vector<CallInfo> m_calls;
-    std::vector<size_t>   m_lineOffset;
-    bool m_showLineNumbers = false;
+    struct StringRef
+    {
+      uint32_t offset;
+      uint32_t length;
+    };
+    struct TooltipInfo
+    {
+      QCString       id;
+      DocLinkInfo    docInfo;
+      QCString       decl;
+      QCString       desc;
+      SourceLinkInfo defInfo;
+      SourceLinkInfo declInfo;
+    };
+    void startNewLine(int lineNr);
+    void addCall(Op op,int value=0,bool flag=false);
+    void addString(const QCString &s);
+    QCString getString(uint32_t index) const;
+    std::vector<Call>        m_calls;
+    std::vector<StringRef>   m_args;
+    std::string              m_text;
+    std::vector<TooltipInfo> m_tooltips;
+    std::vector<size_t>      m_lineOffset;
 };
 
 
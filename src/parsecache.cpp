@@ -0,0 +1,763 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <iterator>
+#include <unordered_map>
+
+#include "parsecache.h"
+#include "serialization.h"
+#include "entry.h"
+#include "config.h"
+#include "message.h"
+#include "portable.h"
+#include "fileinfo.h"
+#include "dir.h"
+#include "md5.h"
+#include "version.h"
+#include "trace.h"
+#include "threadpool.h"
+
+// bump this whenever the layout of the cache files changes
+static const uint32_t g_formatVersion = 1;
+static const char    *g_magic         = "DOXYGEN_PARSE_CACHE";
+static const char    *g_macrosMagic   = "DOXYGEN_INCLUDE_MACROS";
+static const char    *g_macrosFile    = "include_macros.cache";
+
+// options that cannot influence the result of parsing a file
+static const StringUnorderedSet g_ignoredOptions =
+{
+  "OUTPUT_DIRECTORY", "HTML_OUTPUT", "LATEX_OUTPUT", "RTF_OUTPUT", "MAN_OUTPUT",
+  "XML_OUTPUT", "DOCBOOK_OUTPUT", "SQLITE3_OUTPUT", "PARSE_CACHE_DIR",
+  "NUM_PROC_THREADS", "DOT_NUM_THREADS", "QUIET", "LOOKUP_CACHE_FILE"
+};
+
+// options that influence which include files are read and which macros they define
+static const StringVector g_preprocessorOptions =
+{
+  "ENABLE_PREPROCESSING", "MACRO_EXPANSION", "EXPAND_ONLY_PREDEF", "SEARCH_INCLUDES",
+  "INCLUDE_PATH", "INCLUDE_FILE_PATTERNS", "EXCLUDE_PATTERNS", "PREDEFINED", "EXPAND_AS_DEFINED"
+};
+
+// set when the file parsed by this thread changed state that the cache cannot restore
+static thread_local bool g_uncacheable = false;
+static ThreadStateRegistration g_uncacheableState([]()
+{
+  bool uncacheable = g_uncacheable;
+  return std::function<void()>([uncacheable]() { g_uncacheable = uncacheable; });
+});
+
+static std::string md5String(const char *data,size_t len)
+{
+  uint8_t md5_sig[16];
+  char sigStr[33];
+  MD5Buffer(data,static_cast<unsigned int>(len),md5_sig);
+  MD5SigToString(md5_sig,sigStr);
+  return sigStr;
+}
+
+static bool readFile(const QCString &fileName,std::string &contents)
+{
+  std::ifstream f = Portable::openInputStream(fileName,true);
+  if (!f.is_open()) return false;
+  contents.assign(std::istreambuf_iterator<char>(f),std::istreambuf_iterator<char>());
+  return true;
+}
+
+// write to a temporary file first, so concurrent runs never see a partial cache file
+static bool writeFile(const QCString &fileName,const std::string &contents)
+{
+  QCString tmpFile = fileName+QCString().sprintf(".%u.tmp",Portable::pid());
+  {
+    std::ofstream f = Portable::openOutputStream(tmpFile);
+    if (!f.is_open()) return false;
+    f.write(contents.data(),static_cast<std::streamsize>(contents.size()));
+    if (!f.good()) { f.close(); Portable::unlink(tmpFile); return false; }
+  }
+  Dir dir;
+  if (!dir.rename(tmpFile.str(),fileName.str()))
+  {
+    Portable::unlink(tmpFile);
+    return false;
+  }
+  return true;
+}
+
+static void appendOption(std::string &text,const std::string &name)
+{
+  ConfigValues &cv = ConfigValues::instance();
+  const ConfigValues::Info *opt = cv.get(name.c_str());
+  if (opt==nullptr) return;
+  text+='\n';
+  text+=name;
+  text+='=';
+  switch (opt->type)
+  {
+    case ConfigValues::Info::Bool:   text+=(cv.*(opt->value.b)) ? "YES" : "NO";   break;
+    case ConfigValues::Info::Int:    text+=std::to_string(cv.*(opt->value.i));    break;
+    case ConfigValues::Info::String: text+=(cv.*(opt->value.s)).str();            break;
+    case ConfigValues::Info::List:
+      for (const auto &item : cv.*(opt->value.l))
+      {
+        text+=item;
+        text+='\t';
+      }
+      break;
+    case ConfigValues::Info::Unknown: break;
+  }
+}
+
+static std::string computeConfigFingerprint()
+{
+  std::string text = getFullVersion();
+  for (const auto &name : ConfigValues::instance().fields())
+  {
+    if (g_ignoredOptions.find(name)==g_ignoredOptions.end())
+    {
+      appendOption(text,name);
+    }
+  }
+  return md5String(text.data(),text.size());
+}
+
+// the macros found in include files only depend on these options
+static std::string computePreprocessorFingerprint()
+{
+  std::string text = getFullVersion();
+  for (const auto &name : g_preprocessorOptions)
+  {
+    appendOption(text,name);
+  }
+  return md5String(text.data(),text.size());
+}
+
+//---------------------------------------------------------------------------------------------
+
+static void writeArgumentList(Serializer &s,const ArgumentList &al)
+{
+  s.writeSize(al.size());
+  for (const Argument &a : al)
+  {
+    s.writeString(a.attrib);
+    s.writeString(a.type);
+    s.writeString(a.canType);
+    s.writeString(a.name);
+    s.writeString(a.array);
+    s.writeString(a.defval);
+    s.writeString(a.docs);
+    s.writeString(a.typeConstraint);
+  }
+  s.writeBool(al.constSpecifier());
+  s.writeBool(al.volatileSpecifier());
+  s.writeBool(al.pureSpecifier());
+  s.writeString(al.trailingReturnType());
+  s.writeBool(al.isDeleted());
+  s.writeEnum(al.refQualifier());
+  s.writeBool(al.noParameters());
+}
+
+static void readArgumentList(Deserializer &d,ArgumentList &al)
+{
+  size_t count = d.readSize();
+  for (size_t i=0; i<count && !d.failed(); i++)
+  {
+    Argument a;
+    a.attrib         = d.readQCString();
+    a.type           = d.readQCString();
+    a.canType        = d.readQCString();
+    a.name           = d.readQCString();
+    a.array          = d.readQCString();
+    a.defval         = d.readQCString();
+    a.docs           = d.readQCString();
+    a.typeConstraint = d.readQCString();
+    al.push_back(a);
+  }
+  al.setConstSpecifier(d.readBool());
+  al.setVolatileSpecifier(d.readBool());
+  al.setPureSpecifier(d.readBool());
+  al.setTrailingReturnType(d.readQCString());
+  al.setIsDeleted(d.readBool());
+  al.setRefQualifier(d.readEnum<RefQualifierType>());
+  al.setNoParameters(d.readBool());
+}
+
+static void writeEntry(Serializer &s,const Entry &e)
+{
+  s.writeRaw(e.section);
+  s.writeString(e.type);
+  s.writeString(e.name);
+  s.writeBool(e.hasTagInfo);
+  s.writeString(e.tagInfoData.tagName);
+  s.writeString(e.tagInfoData.fileName);
+  s.writeString(e.tagInfoData.anchor);
+  s.writeEnum(e.protection);
+  s.writeEnum(e.mtype);
+  s.writeRaw(e.spec);
+  s.writeEnum(e.vhdlSpec);
+  s.writeInt(e.initLines);
+  s.writeBool(e.isStatic);
+  s.writeBool(e.explicitExternal);
+  s.writeBool(e.proto);
+  s.writeBool(e.subGrouping);
+  s.writeBool(e.exported);
+  s.writeRaw(e.commandOverrides);
+  s.writeEnum(e.virt);
+  s.writeString(e.args);
+  s.writeString(e.bitfields);
+  writeArgumentList(s,e.argList);
+  s.writeSize(e.tArgLists.size());
+  for (const auto &al : e.tArgLists)
+  {
+    writeArgumentList(s,al);
+  }
+  s.writeString(e.program.str());
+  s.writeString(e.initializer.str());
+  s.writeString(e.includeFile);
+  s.writeString(e.includeName);
+  s.writeString(e.doc);
+  s.writeInt(e.docLine);
+  s.writeString(e.docFile);
+  s.writeString(e.brief);
+  s.writeInt(e.briefLine);
+  s.writeString(e.briefFile);
+  s.writeString(e.inbodyDocs);
+  s.writeInt(e.inbodyLine);
+  s.writeString(e.inbodyFile);
+  s.writeString(e.relates);
+  s.writeEnum(e.relatesType);
+  s.writeString(e.read);
+  s.writeString(e.write);
+  s.writeString(e.inside);
+  s.writeString(e.exception);
+  writeArgumentList(s,e.typeConstr);
+  s.writeInt(e.bodyLine);
+  s.writeInt(e.bodyColumn);
+  s.writeInt(e.endBodyLine);
+  s.writeInt(e.mGrpId);
+  s.writeSize(e.extends.size());
+  for (const auto &bi : e.extends)
+  {
+    s.writeString(bi.name);
+    s.writeEnum(bi.prot);
+    s.writeEnum(bi.virt);
+  }
+  s.writeSize(e.groups.size());
+  for (const auto &g : e.groups)
+  {
+    s.writeString(g.groupname);
+    s.writeEnum(g.pri);
+  }
+  s.writeString(e.fileName);
+  s.writeInt(e.startLine);
+  s.writeInt(e.startColumn);
+  s.writeEnum(e.lang);
+  s.writeBool(e.hidden);
+  s.writeBool(e.artificial);
+  s.writeEnum(e.groupDocType);
+  s.writeString(e.id);
+  s.writeRaw(e.localToc);
+  s.writeString(e.metaData);
+  s.writeString(e.req);
+  s.writeSize(e.qualifiers.size());
+  for (const auto &q : e.qualifiers)
+  {
+    s.writeString(q);
+  }
+  s.writeSize(e.children().size());
+  for (const auto &child : e.children())
+  {
+    writeEntry(s,*child);
+  }
+}
+
+static std::shared_ptr<Entry> readEntry(Deserializer &d)
+{
+  auto e = makeEntry();
+  d.readRaw(e->section);
+  e->type = d.readQCString();
+  e->name = d.readQCString();
+  e->hasTagInfo = d.readBool();
+  e->tagInfoData.tagName  = d.readQCString();
+  e->tagInfoData.fileName = d.readQCString();
+  e->tagInfoData.anchor   = d.readQCString();
+  e->protection = d.readEnum<Protection>();
+  e->mtype = d.readEnum<MethodTypes>();
+  d.readRaw(e->spec);
+  e->vhdlSpec = d.readEnum<VhdlSpecifier>();
+  e->initLines = d.readInt();
+  e->isStatic = d.readBool();
+  e->explicitExternal = d.readBool();
+  e->proto = d.readBool();
+  e->subGrouping = d.readBool();
+  e->exported = d.readBool();
+  d.readRaw(e->commandOverrides);
+  e->virt = d.readEnum<Specifier>();
+  e->args = d.readQCString();
+  e->bitfields = d.readQCString();
+  readArgumentList(d,e->argList);
+  size_t numTArgLists = d.readSize();
+  for (size_t i=0; i<numTArgLists && !d.failed(); i++)
+  {
+    ArgumentList al;
+    readArgumentList(d,al);
+    e->tArgLists.push_back(al);
+  }
+  e->program.str(d.readString());
+  e->initializer.str(d.readString());
+  e->includeFile = d.readQCString();
+  e->includeName = d.readQCString();
+  e->doc = d.readQCString();
+  e->docLine = d.readInt();
+  e->docFile = d.readQCString();
+  e->brief = d.readQCString();
+  e->briefLine = d.readInt();
+  e->briefFile = d.readQCString();
+  e->inbodyDocs = d.readQCString();
+  e->inbodyLine = d.readInt();
+  e->inbodyFile = d.readQCString();
+  e->relates = d.readQCString();
+  e->relatesType = d.readEnum<RelatesType>();
+  e->read = d.readQCString();
+  e->write = d.readQCString();
+  e->inside = d.readQCString();
+  e->exception = d.readQCString();
+  readArgumentList(d,e->typeConstr);
+  e->bodyLine = d.readInt();
+  e->bodyColumn = d.readInt();
+  e->endBodyLine = d.readInt();
+  e->mGrpId = d.readInt();
+  size_t numExtends = d.readSize();
+  for (size_t i=0; i<numExtends && !d.failed(); i++)
+  {
+    QCString name  = d.readQCString();
+    Protection prot = d.readEnum<Protection>();
+    Specifier virt = d.readEnum<Specifier>();
+    e->extends.emplace_back(name,prot,virt);
+  }
+  size_t numGroups = d.readSize();
+  for (size_t i=0; i<numGroups && !d.failed(); i++)
+  {
+    QCString name = d.readQCString();
+    Grouping::GroupPri_t pri = d.readEnum<Grouping::GroupPri_t>();
+    e->groups.emplace_back(name,pri);
+  }
+  e->fileName = d.readQCString();
+  e->startLine = d.readInt();
+  e->startColumn = d.readInt();
+  e->lang = d.readEnum<SrcLangExt>();
+  e->hidden = d.readBool();
+  e->artificial = d.readBool();
+  e->groupDocType = d.readEnum<Entry::GroupDocType>();
+  e->id = d.readQCString();
+  d.readRaw(e->localToc);
+  e->metaData = d.readQCString();
+  e->req = d.readQCString();
+  size_t numQualifiers = d.readSize();
+  for (size_t i=0; i<numQualifiers && !d.failed(); i++)
+  {
+    e->qualifiers.push_back(d.readString());
+  }
+  size_t numChildren = d.readSize();
+  for (size_t i=0; i<numChildren && !d.failed(); i++)
+  {
+    e->moveToSubEntryAndKeep(readEntry(d));
+  }
+  return d.failed() ? nullptr : e;
+}
+
+// returns TRUE if the tree does not refer to sections or cross reference items,
+// which are registered globally while parsing and cannot be restored from the cache.
+static bool isSelfContained(const Entry &e)
+{
+  if (!e.anchors.empty() || !e.sli.empty()) return false;
+  for (const auto &child : e.children())
+  {
+    if (!isSelfContained(*child)) return false;
+  }
+  return true;
+}
+
+static void writeDefineList(Serializer &s,const DefineList &defines)
+{
+  s.writeSize(defines.size());
+  for (const auto &def : defines)
+  {
+    s.writeString(def.name);
+    s.writeString(def.definition);
+    s.writeString(def.fileName);
+    s.writeString(def.args);
+    s.writeInt(def.lineNr);
+    s.writeInt(def.columnNr);
+    s.writeInt(def.nargs);
+    s.writeBool(def.undef);
+    s.writeBool(def.varArgs);
+    s.writeBool(def.isPredefined);
+    s.writeBool(def.nonRecursive);
+    s.writeBool(def.expandAsDefined);
+  }
+}
+
+static void readDefineList(Deserializer &d,DefineList &defines)
+{
+  size_t numDefines = d.readSize();
+  for (size_t i=0; i<numDefines && !d.failed(); i++)
+  {
+    Define def;
+    def.name            = d.readQCString();
+    def.definition      = d.readQCString();
+    def.fileName        = d.readQCString();
+    def.args            = d.readQCString();
+    def.lineNr          = d.readInt();
+    def.columnNr        = d.readInt();
+    def.nargs           = d.readInt();
+    def.undef           = d.readBool();
+    def.varArgs         = d.readBool();
+    def.isPredefined    = d.readBool();
+    def.nonRecursive    = d.readBool();
+    def.expandAsDefined = d.readBool();
+    defines.push_back(def);
+  }
+}
+
+static void writeFootprint(Serializer &s,const Preprocessor::Footprint &fp)
+{
+  s.writeSize(fp.includes.size());
+  for (const auto &inc : fp.includes)
+  {
+    s.writeString(inc.fileName);
+    s.writeString(inc.includeName);
+    s.writeBool(inc.local);
+    s.writeBool(inc.imported);
+  }
+  writeDefineList(s,fp.macroDefinitions);
+}
+
+static void readFootprint(Deserializer &d,Preprocessor::Footprint &fp)
+{
+  size_t numIncludes = d.readSize();
+  for (size_t i=0; i<numIncludes && !d.failed(); i++)
+  {
+    Preprocessor::Footprint::Include inc;
+    inc.fileName    = d.readQCString();
+    inc.includeName = d.readQCString();
+    inc.local       = d.readBool();
+    inc.imported    = d.readBool();
+    fp.includes.push_back(inc);
+  }
+  readDefineList(d,fp.macroDefinitions);
+}
+
+//---------------------------------------------------------------------------------------------
+
+struct ParseCache::Private
+{
+  bool                enabled = false;
+  QCString            dir;
+  std::string         fingerprint;
+  std::string         preprocessorFingerprint;
+  std::mutex          hashMutex;
+  StringUnorderedMap  fileHashes; // content hash per dependency, computed at most once per run
+  std::atomic<size_t> hits   = 0;
+  std::atomic<size_t> misses = 0;
+  std::atomic<size_t> stored = 0;
+  size_t              restoredIncludes = 0;
+
+  QCString cacheFileName(const QCString &fileName) const
+  {
+    return dir+"/"+md5String(fileName.data(),fileName.length())+".entries";
+  }
+
+  std::string fileHash(const std::string &fileName)
+  {
+    {
+      std::lock_guard<std::mutex> lock(hashMutex);
+      auto it = fileHashes.find(fileName);
+      if (it!=fileHashes.end()) return it->second;
+    }
+    std::string contents;
+    std::string hash = readFile(QCString(fileName),contents) ? md5String(contents.data(),contents.size()) : std::string();
+    std::lock_guard<std::mutex> lock(hashMutex);
+    fileHashes.emplace(fileName,hash);
+    return hash;
+  }
+};
+
+ParseCache::ParseCache() : p(std::make_unique<Private>())
+{
+}
+
+ParseCache::~ParseCache() = default;
+
+ParseCache &ParseCache::instance()
+{
+  static ParseCache cache;
+  return cache;
+}
+
+void ParseCache::initialize()
+{
+  QCString dirName = Config_getString(PARSE_CACHE_DIR);
+  p->enabled = false;
+  if (dirName.isEmpty()) return;
+
+  Dir dir(dirName.str());
+  if (!dir.exists() && !dir.mkdir(dirName.str()))
+  {
+    warn_uncond("tag PARSE_CACHE_DIR: directory '%s' does not exist and cannot be created, parse cache disabled\n",
+        qPrint(dirName));
+    return;
+  }
+  p->dir         = dir.absPath();
+  p->fingerprint = computeConfigFingerprint();
+  p->preprocessorFingerprint = computePreprocessorFingerprint();
+  p->enabled     = true;
+  AUTO_TRACE("dir={} fingerprint={}",p->dir,p->fingerprint);
+}
+
+std::string ParseCache::configFingerprint()
+{
+  return computeConfigFingerprint();
+}
+
+bool ParseCache::isEnabled() const
+{
+  return p->enabled;
+}
+
+std::string ParseCache::contentHash(const std::string &input)
+{
+  return md5String(input.data(),input.size());
+}
+
+std::shared_ptr<Entry> ParseCache::find(const QCString &fileName,const std::string &hash)
+{
+  if (!p->enabled) return nullptr;
+  AUTO_TRACE("fileName={}",fileName);
+  std::string data;
+  if (!readFile(p->cacheFileName(fileName),data))
+  {
+    p->misses++;
+    return nullptr;
+  }
+  Deserializer d(data);
+  bool valid = d.readString()==g_magic &&
+               d.readUInt()==g_formatVersion &&
+               d.readString()==p->fingerprint &&
+               d.readQCString()==fileName &&
+               d.readString()==hash;
+  if (valid)
+  {
+    // check that none of the included files changed
+    size_t numDeps = d.readSize();
+    for (size_t i=0; i<numDeps && valid && !d.failed(); i++)
+    {
+      std::string depName = d.readString();
+      std::string depHash = d.readString();
+      valid = p->fileHash(depName)==depHash;
+    }
+  }
+  if (!valid || d.failed())
+  {
+    AUTO_TRACE_EXIT("outdated");
+    p->misses++;
+    return nullptr;
+  }
+  Preprocessor::Footprint fp;
+  readFootprint(d,fp);
+  std::shared_ptr<Entry> root = readEntry(d);
+  if (!root || d.failed() || !d.atEnd())
+  {
+    AUTO_TRACE_EXIT("corrupt");
+    p->misses++;
+    return nullptr;
+  }
+  Preprocessor::restoreFootprint(fileName,fp);
+  p->hits++;
+  AUTO_TRACE_EXIT("hit");
+  return root;
+}
+
+void ParseCache::store(const QCString &fileName,const std::string &hash,
+                       const Preprocessor::Footprint &fp,const Entry &root)
+{
+  if (!p->enabled || !isSelfContained(root)) return;
+  AUTO_TRACE("fileName={}",fileName);
+  Serializer s;
+  s.writeString(std::string(g_magic));
+  s.writeUInt(g_formatVersion);
+  s.writeString(p->fingerprint);
+  s.writeString(fileName);
+  s.writeString(hash);
+  s.writeSize(fp.dependencies.size());
+  for (const auto &dep : fp.dependencies)
+  {
+    s.writeString(dep);
+    s.writeString(p->fileHash(dep));
+  }
+  writeFootprint(s,fp);
+  writeEntry(s,root);
+
+  if (writeFile(p->cacheFileName(fileName),s.data()))
+  {
+    p->stored++;
+  }
+}
+
+void ParseCache::restoreIncludeMacros()
+{
+  if (!p->enabled) return;
+  AUTO_TRACE();
+  std::string data;
+  if (!readFile(p->dir+"/"+g_macrosFile,data)) return;
+  Deserializer d(data);
+  if (d.readString()!=g_macrosMagic ||
+      d.readUInt()!=g_formatVersion ||
+      d.readString()!=p->preprocessorFingerprint)
+  {
+    AUTO_TRACE_EXIT("outdated");
+    return;
+  }
+
+  // files that changed since the macros were stored
+  StringUnorderedSet changed;
+  size_t numFiles = d.readSize();
+  for (size_t i=0; i<numFiles && !d.failed(); i++)
+  {
+    std::string fileName = d.readString();
+    std::string hash     = d.readString();
+    if (p->fileHash(fileName)!=hash)
+    {
+      changed.insert(fileName);
+    }
+  }
+
+  Preprocessor::IncludeMacrosMap macros;
+  size_t numEntries = d.readSize();
+  for (size_t i=0; i<numEntries && !d.failed(); i++)
+  {
+    std::string fileName = d.readString();
+    Preprocessor::IncludeMacros &im = macros[fileName];
+    size_t numIncludes = d.readSize();
+    for (size_t j=0; j<numIncludes && !d.failed(); j++)
+    {
+      im.includedFiles.push_back(d.readString());
+    }
+    readDefineList(d,im.defines);
+  }
+  if (d.failed() || !d.atEnd())
+  {
+    AUTO_TRACE_EXIT("corrupt");
+    return;
+  }
+
+  // a file's macros are only valid if neither the file nor anything it includes changed
+  std::unordered_map<std::string,bool> valid;
+  std::function<bool(const std::string &)> isValid = [&](const std::string &fileName)
+  {
+    auto it = valid.find(fileName);
+    if (it!=valid.end()) return it->second;
+    bool ok = changed.find(fileName)==changed.end();
+    valid[fileName] = ok; // assume valid while visiting, to deal with include cycles
+    auto mit = macros.find(fileName);
+    if (ok && mit!=macros.end())
+    {
+      for (const auto &incFile : mit->second.includedFiles)
+      {
+        if (!isValid(incFile)) { ok=false; break; }
+      }
+    }
+    valid[fileName] = ok;
+    return ok;
+  };
+  for (auto it = macros.begin(); it!=macros.end();)
+  {
+    if (isValid(it->first)) ++it; else it = macros.erase(it);
+  }
+  p->restoredIncludes = macros.size();
+  Preprocessor::restoreIncludeMacros(macros);
+  AUTO_TRACE_EXIT("restored {} of {} files",macros.size(),numEntries);
+}
+
+void ParseCache::storeIncludeMacros()
+{
+  if (!p->enabled) return;
+  AUTO_TRACE();
+  Preprocessor::IncludeMacrosMap macros = Preprocessor::includeMacros();
+
+  // record the contents of every file that the stored macros depend on
+  StringSet files;
+  for (const auto &[fileName,im] : macros)
+  {
+    files.insert(fileName);
+    files.insert(im.includedFiles.begin(),im.includedFiles.end());
+  }
+
+  Serializer s;
+  s.writeString(std::string(g_macrosMagic));
+  s.writeUInt(g_formatVersion);
+  s.writeString(p->preprocessorFingerprint);
+  s.writeSize(files.size());
+  for (const auto &fileName : files)
+  {
+    s.writeString(fileName);
+    s.writeString(p->fileHash(fileName));
+  }
+  s.writeSize(macros.size());
+  for (const auto &[fileName,im] : macros)
+  {
+    s.writeString(fileName);
+    s.writeSize(im.includedFiles.size());
+    for (const auto &incFile : im.includedFiles)
+    {
+      s.writeString(incFile);
+    }
+    writeDefineList(s,im.defines);
+  }
+  writeFile(p->dir+"/"+g_macrosFile,s.data());
+}
+
+bool ParseCache::readCacheFile(const QCString &name,std::string &contents) const
+{
+  return p->enabled && readFile(p->dir+"/"+name,contents);
+}
+
+bool ParseCache::writeCacheFile(const QCString &name,const std::string &contents) const
+{
+  return p->enabled && writeFile(p->dir+"/"+name,contents);
+}
+
+void ParseCache::printStatistics() const
+{
+  if (!p->enabled) return;
+  msg("Parse cache: restored %zu of %zu files, stored %zu files, restored the macros of %zu include files.\n",
+      p->hits.load(),p->hits.load()+p->misses.load(),p->stored.load(),p->restoredIncludes);
+}
+
+void ParseCache::markUncacheable()
+{
+  g_uncacheable = true;
+}
+
+ParseCache::Recorder::Recorder() : m_warnCount(warnCountForCurrentThread())
+{
+  g_uncacheable = false;
+}
+
+bool ParseCache::Recorder::isCacheable() const
+{
+  return !g_uncacheable && warnCountForCurrentThread()==m_warnCount;
+}
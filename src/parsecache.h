@@ -0,0 +1,121 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef PARSECACHE_H
+#define PARSECACHE_H
+
+#include <memory>
+#include <string>
+
+#include "qcstring.h"
+#include "construct.h"
+#include "pre.h"
+
+class Entry;
+
+/** @brief Persistent cache of the Entry trees produced by parsing the input files.
+ *
+ *  When \c PARSE_CACHE_DIR is set, the Entry tree produced for an input file
+ *  is stored in that directory together with the preprocessor's footprint.
+ *  The cache key consists of the contents of the file, the contents of all
+ *  files it includes, and a fingerprint of the configuration. On a later run
+ *  an unchanged file can then skip preprocessing, comment conversion and
+ *  parsing altogether.
+ *
+ *  The macros defined by each include file are also stored, so on a later run
+ *  include files that did not change are not read again by the preprocessor,
+ *  even if the files that include them did change.
+ *
+ *  Files whose parsing changes global state that cannot be restored from the
+ *  cache (sections, cross reference items, formulas, citations, ...) or that
+ *  produce warnings are never stored, so they are always parsed again.
+ */
+class ParseCache
+{
+  public:
+    static ParseCache &instance();
+
+    /** Prepares the cache directory and computes the configuration fingerprint. */
+    void initialize();
+
+    /** Returns TRUE if the cache is enabled via the configuration. */
+    bool isEnabled() const;
+
+    /** Returns a key representing the configuration options that can influence parsing. */
+    static std::string configFingerprint();
+
+    /** Returns the key representing the contents \a input of an input file. */
+    static std::string contentHash(const std::string &input);
+
+    /** Returns the Entry tree for \a fileName if its contents hash to \a hash and
+     *  none of its dependencies changed, or nullptr otherwise.
+     *  On a hit the global state recorded for the file is restored.
+     */
+    std::shared_ptr<Entry> find(const QCString &fileName,const std::string &hash);
+
+    /** Stores the result of parsing \a fileName with contents hash \a hash. */
+    void store(const QCString &fileName,const std::string &hash,
+               const Preprocessor::Footprint &fp,const Entry &root);
+
+    /** Makes the macros of the include files stored by an earlier run available to
+     *  the preprocessor, for the include files that did not change since. The stored
+     *  macros are only used when the preprocessor related options are the same.
+     */
+    void restoreIncludeMacros();
+
+    /** Stores the macros of all include files processed by the preprocessor in this run. */
+    void storeIncludeMacros();
+
+    /** Reads the file \a name from the cache directory into \a contents.
+     *  Returns FALSE if the cache is disabled or the file cannot be read.
+     */
+    bool readCacheFile(const QCString &name,std::string &contents) const;
+
+    /** Replaces the file \a name in the cache directory by \a contents.
+     *  Returns FALSE if the cache is disabled or the file cannot be written.
+     */
+    bool writeCacheFile(const QCString &name,const std::string &contents) const;
+
+    /** Reports the number of cache hits and misses. */
+    void printStatistics() const;
+
+    /** Marks the file being parsed by the calling thread as one whose result
+     *  cannot be restored from the cache.
+     */
+    static void markUncacheable();
+
+    /** @brief Tracks if the file parsed by the calling thread can be stored in the cache.
+     *
+     *  Create an instance before parsing a file and check isCacheable() after parsing it.
+     */
+    class Recorder
+    {
+      public:
+        Recorder();
+        NON_COPYABLE(Recorder)
+        bool isCacheable() const;
+      private:
+        size_t m_warnCount;
+    };
+
+  private:
+    ParseCache();
+   ~ParseCache();
+    NON_COPYABLE(ParseCache)
+    struct Private;
+    std::unique_ptr<Private> p;
+};
+
+#endif
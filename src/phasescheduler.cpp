@@ -0,0 +1,188 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+
+#include "phasescheduler.h"
+#include "threadpool.h"
+#include "message.h"
+#include "chrometrace.h"
+
+struct Phase
+{
+  const char *name;
+  StringVector reads;
+  StringVector writes;
+  std::function<void()> work;
+  std::vector<size_t> dependents;
+  size_t numDependencies = 0;
+  double elapsed = 0.0;
+};
+
+static bool intersects(const StringVector &v1,const StringVector &v2)
+{
+  return std::any_of(v1.begin(),v1.end(),
+      [&v2](const auto &s) { return std::find(v2.begin(),v2.end(),s)!=v2.end(); });
+}
+
+//! returns TRUE if phase \a later must wait for phase \a earlier to finish
+static bool conflicts(const Phase &earlier,const Phase &later)
+{
+  return intersects(earlier.writes,later.reads)  ||
+         intersects(earlier.writes,later.writes) ||
+         intersects(earlier.reads, later.writes);
+}
+
+static void runPhase(Phase &phase)
+{
+  msg("%s",phase.name);
+  ChromeTrace::Span span("phase",QCString(phase.name).stripWhiteSpace());
+  auto startTime = std::chrono::steady_clock::now();
+  phase.work();
+  auto endTime = std::chrono::steady_clock::now();
+  phase.elapsed = static_cast<double>(std::chrono::duration_cast<
+                     std::chrono::microseconds>(endTime - startTime).count())/1000000.0;
+}
+
+struct PhaseScheduler::Private
+{
+  std::vector<Phase> phases;
+};
+
+PhaseScheduler::PhaseScheduler() : p(std::make_unique<Private>())
+{
+}
+
+PhaseScheduler::~PhaseScheduler() = default;
+
+void PhaseScheduler::add(const char *name,const StringVector &reads,const StringVector &writes,
+                         std::function<void()> work)
+{
+  size_t index = p->phases.size();
+  p->phases.push_back(Phase{name,reads,writes,std::move(work),{},0,0.0});
+  Phase &phase = p->phases.back();
+  for (size_t i=0; i<index; i++)
+  {
+    if (conflicts(p->phases[i],phase))
+    {
+      p->phases[i].dependents.push_back(index);
+      phase.numDependencies++;
+    }
+  }
+}
+
+void PhaseScheduler::run(size_t numThreads)
+{
+  if (numThreads<=1 || p->phases.size()<=1)
+  {
+    for (auto &phase : p->phases)
+    {
+      runPhase(phase);
+    }
+    return;
+  }
+
+  std::mutex mutex;
+  std::condition_variable finishedCond;
+  std::deque<size_t> finished;
+  std::vector< std::future<void> > results(p->phases.size());
+  std::vector<size_t> waitingFor;
+  for (const auto &phase : p->phases) waitingFor.push_back(phase.numDependencies);
+
+  ThreadPool threadPool(std::min(numThreads,p->phases.size()),"phases");
+  auto schedule = [&](size_t index)
+  {
+    results[index] = threadPool.queue([&,index]()
+    {
+      try
+      {
+        runPhase(p->phases[index]);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.push_back(index);
+        finishedCond.notify_one();
+        throw;
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      finished.push_back(index);
+      finishedCond.notify_one();
+    });
+  };
+
+  // start all phases that do not depend on others, in the order they were added
+  size_t numRunning = 0;
+  for (size_t i=0; i<p->phases.size(); i++)
+  {
+    if (waitingFor[i]==0)
+    {
+      schedule(i);
+      numRunning++;
+    }
+  }
+  // each time a phase finishes, start the phases that no longer have to wait for anything.
+  // After a phase failed no new phases are started, but the running ones are waited for
+  // before the first exception is passed on, as they may still use the caller's state.
+  std::exception_ptr error;
+  while (numRunning>0)
+  {
+    size_t index = 0;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      finishedCond.wait(lock,[&finished]() { return !finished.empty(); });
+      index = finished.front();
+      finished.pop_front();
+    }
+    numRunning--;
+    try
+    {
+      results[index].get(); // propagates exceptions thrown by the phase
+    }
+    catch (...)
+    {
+      if (!error) error = std::current_exception();
+    }
+    if (error) continue;
+    for (size_t dep : p->phases[index].dependents)
+    {
+      if (--waitingFor[dep]==0)
+      {
+        schedule(dep);
+        numRunning++;
+      }
+    }
+  }
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+std::vector<PhaseScheduler::Timing> PhaseScheduler::timings() const
+{
+  std::vector<Timing> result;
+  result.reserve(p->phases.size());
+  for (const auto &phase : p->phases)
+  {
+    result.push_back({phase.name,phase.elapsed});
+  }
+  return result;
+}
@@ -0,0 +1,79 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef PHASESCHEDULER_H
+#define PHASESCHEDULER_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "containers.h"
+#include "construct.h"
+
+/** @brief Runs a number of processing phases, overlapping the ones that are independent.
+ *
+ *  Each phase declares the resources it reads and the resources it writes.
+ *  A phase depends on every phase added before it that writes a resource it
+ *  reads or writes, or that reads a resource it writes. Phases without such
+ *  a conflict may run concurrently. When only one thread is used, the phases
+ *  run in the order in which they were added.
+ *
+ *  Usage example:
+ *  @code
+ *  PhaseScheduler scheduler;
+ *  scheduler.add("Phase A...\n",{},{"dirs"},[]() { ... });
+ *  scheduler.add("Phase B...\n",{},{"pages"},[]() { ... });
+ *  scheduler.add("Phase C...\n",{"dirs","pages"},{},[]() { ... }); // runs after A and B
+ *  scheduler.run(numThreads);
+ *  for (const auto &t : scheduler.timings()) printf("%s took %f\n",t.name,t.elapsed);
+ *  @endcode
+ */
+class PhaseScheduler
+{
+  public:
+    /** Time spent in a phase. */
+    struct Timing
+    {
+      const char *name;
+      double elapsed;
+    };
+
+    PhaseScheduler();
+   ~PhaseScheduler();
+    NON_COPYABLE(PhaseScheduler)
+
+    /** Adds a phase called \a name that reads the resources \a reads,
+     *  writes the resources \a writes, and performs \a work.
+     *  The name is printed when the phase starts and must remain valid
+     *  for the lifetime of the scheduler.
+     */
+    void add(const char *name,const StringVector &reads,const StringVector &writes,
+             std::function<void()> work);
+
+    /** Executes all phases using at most \a numThreads threads and
+     *  returns when all of them have finished.
+     */
+    void run(size_t numThreads);
+
+    /** Returns the time spent in each phase, in the order the phases were added. */
+    std::vector<Timing> timings() const;
+
+  private:
+    struct Private;
+    std::unique_ptr<Private> p;
+};
+
+#endif
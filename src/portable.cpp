@@ -19,6 +19,9 @@
 #include <errno.h>
 extern char **environ;
 #endif
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#endif
 
 #include <assert.h>
 #include <ctype.h>
@@ -273,6 +276,32 @@ uint32_t Portable::pid()
   return pid;
 }
 
+/*! Returns the amount of physical memory in bytes used by this process,
+ *  or 0 if this cannot be determined on this platform.
+ */
+size_t Portable::residentMemorySize()
+{
+#if defined(__linux__)
+  std::ifstream f("/proc/self/statm");
+  size_t totalPages=0, residentPages=0;
+  if (f >> totalPages >> residentPages)
+  {
+    return residentPages*static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  }
+  return 0;
+#elif defined(__APPLE__)
+  mach_task_basic_info info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(),MACH_TASK_BASIC_INFO,reinterpret_cast<task_info_t>(&info),&count)==KERN_SUCCESS)
+  {
+    return static_cast<size_t>(info.resident_size);
+  }
+  return 0;
+#else
+  return 0;
+#endif
+}
+
 #if !defined(_WIN32) || defined(__CYGWIN__)
 void loadEnvironment()
 {
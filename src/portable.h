@@ -20,6 +20,7 @@ namespace Portable
 {
   int            system(const QCString &command,const QCString &args,bool commandHasConsole=true);
   uint32_t       pid();
+  size_t         residentMemorySize();
   QCString       getenv(const QCString &variable);
   void           setenv(const QCString &variable,const QCString &value);
   void           unsetenv(const QCString &variable);
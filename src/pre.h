@@ -20,19 +20,74 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "construct.h"
+#include "containers.h"
+#include "define.h"
+
+class StreamPipe;
 
 class QCString;
 
 class Preprocessor
 {
   public:
+    /** Describes the effect of processing a single file on the global state,
+     *  together with the files whose contents were used to produce the output.
+     */
+    struct Footprint
+    {
+      struct Include
+      {
+        QCString fileName;    //!< absolute name of the included file
+        QCString includeName; //!< name used in the #include statement
+        bool local = false;   //!< is it a "local" or <global> include
+        bool imported = false;//!< include via "import" keyword (Objective-C)
+      };
+      StringSet            dependencies;     //!< absolute names of included files that were read or reused
+      std::vector<Include> includes;         //!< include statements found in the file itself
+      DefineList           macroDefinitions; //!< macros defined in the file
+    };
+
+    /** Macros made available by processing an include file, together with the files it includes. */
+    struct IncludeMacros
+    {
+      StringVector includedFiles; //!< absolute names of the files included by the file
+      DefineList   defines;       //!< macros available after processing the file
+    };
+    using IncludeMacrosMap = std::unordered_map< std::string, IncludeMacros >;
+
     Preprocessor();
    ~Preprocessor();
     NON_COPYABLE(Preprocessor)
 
     void processFile(const QCString &fileName,const std::string &input,std::string &output);
+
+    /** Like processFile() but passes the output in chunks to \a output as it is produced,
+     *  so another thread can consume it while the file is being processed.
+     *  The pipe is not closed by this function.
+     */
+    void processFile(const QCString &fileName,const std::string &input,StreamPipe &output);
     void addSearchDir(const QCString &dir);
+
+    /** Returns the footprint of the last call to processFile(). */
+    const Footprint &footprint() const;
+
+    /** Applies a footprint obtained from an earlier run for file \a fileName
+     *  to the global state, as if the file was processed again.
+     */
+    static void restoreFootprint(const QCString &fileName,const Footprint &fp);
+
+    /** Returns the macros of all include files that were completely processed so far,
+     *  keyed by the absolute name of the include file.
+     */
+    static IncludeMacrosMap includeMacros();
+
+    /** Makes the macros of include files obtained in an earlier run available,
+     *  so that these files are not processed again when they are included.
+     */
+    static void restoreIncludeMacros(const IncludeMacrosMap &macros);
  private:
    struct Private;
    std::unique_ptr<Private> p;
@@ -14,6 +14,7 @@
  */
 
 #include "regex.h"
+#include <bitset>
 #include <cstdint>
 #include <vector>
 #include <cctype>
@@ -50,6 +51,16 @@ static inline bool isalnum(char c)
   return isalpha(c) || isdigit(c);
 }
 
+static inline bool isStartIdChar(char c)
+{
+  return isalpha(c) || c=='_';
+}
+
+static inline bool isIdChar(char c)
+{
+  return isalnum(c) || c=='_';
+}
+
 
 /** Class representing a token in the compiled regular expression token stream.
  *  A token has a kind and an optional value whose meaning depends on the kind.
@@ -180,6 +191,7 @@ class Ex::Private
 #endif
     bool matchAt(size_t tokenPos,size_t tokenLen,std::string_view str,
                  Match &match,size_t pos,int level) const;
+    bool matchCharClass(size_t tp,char c) const;
 
     /** Flag indicating the expression was successfully compiled */
     bool error = false;
@@ -189,6 +201,24 @@ class Ex::Private
 
     /** The pattern string as passed by the user */
     std::string pattern;
+
+    /** The characters a match can start with. Only valid if useFirstChars is true. */
+    std::bitset<256> firstChars;
+
+    /** Flag indicating that positions not starting with one of the firstChars can be skipped.
+     *  This is false if the pattern can match an empty string or any character.
+     */
+    bool useFirstChars = false;
+
+    /** A character that is part of every match, or -1 if there is no such character */
+    int requiredChar = -1;
+
+  private:
+    enum class Nullable { No, Yes, Unknown };
+    size_t elementLength(size_t tp) const;
+    bool matchElement(size_t tp,char c) const;
+    Nullable addFirstChars(size_t from,size_t to);
+    void computePrefilter();
 };
 
 /** Compiles a regular expression passed as a string into a stream of tokens that can be used for
@@ -403,6 +433,150 @@ void Ex::Private::compile()
     ps++;
   }
   //addToken(PToken(PToken::Kind::End));
+  computePrefilter();
+}
+
+/** Returns the number of tokens used by the single character element starting at \a tp,
+ *  or 0 if the token at \a tp does not match a single character.
+ */
+size_t Ex::Private::elementLength(size_t tp) const
+{
+  PToken tok = data[tp];
+  if (tok.isCharClass()) return tok.value()+1;
+  switch (tok.kind())
+  {
+    case PToken::Kind::Character:
+    case PToken::Kind::Alpha:
+    case PToken::Kind::AlphaNum:
+    case PToken::Kind::WhiteSpace:
+    case PToken::Kind::Digit:
+    case PToken::Kind::Any:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+/** Returns true if the single character element starting at \a tp matches character \a c */
+bool Ex::Private::matchElement(size_t tp,char c) const
+{
+  PToken tok = data[tp];
+  if (tok.isCharClass()) return matchCharClass(tp,c);
+  switch (tok.kind())
+  {
+    case PToken::Kind::Character:  return c==tok.asciiValue();
+    case PToken::Kind::Alpha:      return isStartIdChar(c);
+    case PToken::Kind::AlphaNum:   return isIdChar(c);
+    case PToken::Kind::WhiteSpace: return isspace(c);
+    case PToken::Kind::Digit:      return isdigit(c);
+    case PToken::Kind::Any:        return true;
+    default:                       return false;
+  }
+}
+
+/** Adds the characters that can start a match of the tokens in range [\a from,\a to) to firstChars.
+ *  Returns whether or not the range can match an empty string.
+ */
+Ex::Private::Nullable Ex::Private::addFirstChars(size_t from,size_t to)
+{
+  auto addElement = [this](size_t tp)
+  {
+    for (size_t c=0;c<firstChars.size();c++)
+    {
+      if (matchElement(tp,static_cast<char>(c))) firstChars.set(c);
+    }
+  };
+  size_t tp = from;
+  while (tp<to)
+  {
+    PToken tok = data[tp];
+    size_t len = elementLength(tp);
+    if (len>0) // a character is required here
+    {
+      addElement(tp);
+      return Nullable::No;
+    }
+    switch (tok.kind())
+    {
+      case PToken::Kind::BeginOfWord: // zero width tokens
+      case PToken::Kind::EndOfWord:
+      case PToken::Kind::BeginCapture:
+      case PToken::Kind::EndCapture:
+        tp++;
+        break;
+      case PToken::Kind::Star:
+      case PToken::Kind::Optional: // [T* T1..Tn TEND] or [T? ( T1..Tn ) TEND]
+        if (tp+1<to && (len=elementLength(tp+1))>0)
+        {
+          addElement(tp+1);
+          tp+=len+2;
+        }
+        else if (tok.kind()==PToken::Kind::Optional && tp+1<to && data[tp+1].kind()==PToken::Kind::BeginCapture)
+        {
+          size_t end = tp+2;
+          while (end<to && data[end].kind()!=PToken::Kind::EndCapture) end++;
+          if (addFirstChars(tp+2,end)==Nullable::Unknown) return Nullable::Unknown;
+          tp=end+2; // skip over EndCapture and End marker
+        }
+        else
+        {
+          return Nullable::Unknown;
+        }
+        break;
+      default: // anchors and end markers
+        return Nullable::Unknown;
+    }
+  }
+  return Nullable::Yes;
+}
+
+/** Determines which characters a match can start with and which character every match contains,
+ *  so match() can skip over parts of the input where no match is possible.
+ */
+void Ex::Private::computePrefilter()
+{
+  firstChars.reset();
+  useFirstChars = false;
+  requiredChar = -1;
+  if (error || data.empty()) return;
+
+  useFirstChars = data[0].kind()!=PToken::Kind::BeginOfLine &&
+                  addFirstChars(0,data.size())==Nullable::No &&
+                  !firstChars.all();
+
+  // a literal character outside of an optional part must be part of every match
+  size_t tp = 0;
+  while (tp<data.size())
+  {
+    PToken tok = data[tp];
+    if (tok.kind()==PToken::Kind::Character)
+    {
+      requiredChar = static_cast<unsigned char>(tok.asciiValue());
+      tp++;
+    }
+    else if (tok.isCharClass())
+    {
+      tp+=tok.value()+1;
+    }
+    else if (tok.kind()==PToken::Kind::Star || tok.kind()==PToken::Kind::Optional)
+    {
+      // skip over the optional part and the End marker closing it
+      size_t len = tp+1<data.size() ? elementLength(tp+1) : 0;
+      if (len>0)
+      {
+        tp+=len+2;
+      }
+      else
+      {
+        while (tp<data.size() && data[tp].kind()!=PToken::Kind::EndCapture) tp++;
+        tp+=2;
+      }
+    }
+    else
+    {
+      tp++;
+    }
+  }
 }
 
 #if ENABLE_DEBUG
@@ -437,6 +611,40 @@ void Ex::Private::dump()
 }
 #endif
 
+/** Returns true if character \a c matches the character class starting at token \a tp */
+bool Ex::Private::matchCharClass(size_t tp,char c) const
+{
+  PToken tok = data[tp];
+  bool negate = tok.kind()==PToken::Kind::NegCharClass;
+  uint16_t numFields = tok.value();
+  bool found = false;
+  for (uint16_t i=0;i<numFields;i++)
+  {
+    tok = data[++tp];
+    // first check for built-in ranges
+    if ((tok.kind()==PToken::Kind::Alpha      && isStartIdChar(c)) ||
+        (tok.kind()==PToken::Kind::AlphaNum   && isIdChar(c))      ||
+        (tok.kind()==PToken::Kind::WhiteSpace && isspace(c))  ||
+        (tok.kind()==PToken::Kind::Digit      && isdigit(c))
+       )
+    {
+      found=true;
+      break;
+    }
+    else // user specified range
+    {
+      uint16_t v = static_cast<uint16_t>(c);
+      if (tok.from()<=v && v<=tok.to())
+      {
+        found=true;
+        break;
+      }
+    }
+  }
+  DBG("matchCharClass(tp=%zu,c=%c (x%02x))=%d\n",tp,c,c,negate?!found:found);
+  return negate ? !found : found;
+}
+
 /** Internal matching routine.
  *  @param tokenPos Offset into the token stream.
  *  @param tokenLen The length of the token stream.
@@ -448,44 +656,9 @@ void Ex::Private::dump()
 bool Ex::Private::matchAt(size_t tokenPos,size_t tokenLen,std::string_view str,Match &match,const size_t pos,int level) const
 {
   DBG("%d:matchAt(tokenPos=%zu, str='%s', pos=%zu)\n",level,tokenPos,pos<str.length() ? str.substr(pos).c_str() : "",pos);
-  auto isStartIdChar = [](char c) { return isalpha(c) || c=='_'; };
-  auto isIdChar      = [](char c) { return isalnum(c) || c=='_'; };
-  auto matchCharClass = [this,isStartIdChar,isIdChar](size_t tp,char c) -> bool
-  {
-    PToken tok = data[tp];
-    bool negate = tok.kind()==PToken::Kind::NegCharClass;
-    uint16_t numFields = tok.value();
-    bool found = false;
-    for (uint16_t i=0;i<numFields;i++)
-    {
-      tok = data[++tp];
-      // first check for built-in ranges
-      if ((tok.kind()==PToken::Kind::Alpha      && isStartIdChar(c)) ||
-          (tok.kind()==PToken::Kind::AlphaNum   && isIdChar(c))      ||
-          (tok.kind()==PToken::Kind::WhiteSpace && isspace(c))  ||
-          (tok.kind()==PToken::Kind::Digit      && isdigit(c))
-         )
-      {
-        found=true;
-        break;
-      }
-      else // user specified range
-      {
-        uint16_t v = static_cast<uint16_t>(c);
-        if (tok.from()<=v && v<=tok.to())
-        {
-          found=true;
-          break;
-        }
-      }
-    }
-    DBG("matchCharClass(tp=%zu,c=%c (x%02x))=%d\n",tp,c,c,negate?!found:found);
-    return negate ? !found : found;
-  };
   size_t index = pos;
   enum SequenceType { Star, Optional, OptionalRange };
-  auto processSequence = [this,&tokenPos,&tokenLen,&index,&str,&matchCharClass,
-                          &isStartIdChar,&isIdChar,&match,&level,&pos](SequenceType type) -> bool
+  auto processSequence = [this,&tokenPos,&tokenLen,&index,&str,&match,&level,&pos](SequenceType type) -> bool
   {
     size_t startIndex = index;
     size_t len = str.length();
@@ -709,6 +882,12 @@ bool Ex::match(std::string_view str,Match &match,size_t pos) const
   if (p->data.size()==0 || p->error) return found;
   match.init(str);
 
+  if (p->requiredChar!=-1 && str.find(static_cast<char>(p->requiredChar),pos)==std::string::npos)
+  {
+    DBG("Ex::match(str='%s',pos=%zu)=false (no required char '%c')\n",str.c_str(),pos,p->requiredChar);
+    return false;
+  }
+
   PToken tok = p->data[0];
   if (tok.kind()==PToken::Kind::BeginOfLine) // only test match at the given position
   {
@@ -716,19 +895,20 @@ bool Ex::match(std::string_view str,Match &match,size_t pos) const
   }
   else
   {
-    if (tok.kind()==PToken::Kind::Character) // search for the start character
+    const size_t len = str.length();
+    const bool singleFirstChar = p->useFirstChars && tok.kind()==PToken::Kind::Character;
+    while (pos<len) // search for a match starting at pos
     {
-      size_t index = str.find(tok.asciiValue(),pos);
-      if (index==std::string::npos)
+      if (singleFirstChar) // search for the start character
       {
-        DBG("Ex::match(str='%s',pos=%zu)=false (no start char '%c')\n",str.c_str(),pos,tok.asciiValue());
-        return false;
+        pos = str.find(tok.asciiValue(),pos);
+        if (pos==std::string::npos) break;
+      }
+      else if (p->useFirstChars) // skip characters that cannot start a match
+      {
+        while (pos<len && !p->firstChars.test(static_cast<unsigned char>(str[pos]))) pos++;
+        if (pos==len) break;
       }
-      DBG("pos=%zu str='%s' char='%c' index=%zu\n",index,str.c_str(),tok.asciiValue(),index);
-      pos=index;
-    }
-    while (pos<str.length()) // search for a match starting at pos
-    {
       found = p->matchAt(0,p->data.size(),str,match,pos,0);
       if (found) break;
       pos++;
@@ -14,6 +14,7 @@
  */
 
 #include <algorithm>
+#include <atomic>
 
 #include "rtfdocvisitor.h"
 #include "docparser.h"
@@ -37,6 +38,7 @@
 #include "fileinfo.h"
 #include "portable.h"
 #include "codefragment.h"
+#include "threadpool.h"
 
 //#define DBG_RTF(x) m_t << x
 #define DBG_RTF(x) do {} while(0)
@@ -75,8 +77,7 @@ RTFDocVisitor::RTFDocVisitor(TextStream &t,OutputCodeList &ci,
 QCString RTFDocVisitor::getStyle(const QCString &name)
 {
   QCString n = name + QCString().setNum(indentLevel());
-  StyleData &sd = rtf_Style[n.str()];
-  return sd.reference();
+  return rtfStyle(n.str()).reference();
 }
 
 QCString RTFDocVisitor::getListTable(const int id)
@@ -364,7 +365,7 @@ void RTFDocVisitor::operator()(const DocVerbatim &s)
       break;
     case DocVerbatim::Dot:
       {
-        static int dotindex = 1;
+        static std::atomic<int> dotindex = 1;
         QCString fileName(4096, QCString::ExplicitSize);
 
         fileName.sprintf("%s%d%s",
@@ -393,7 +394,7 @@ void RTFDocVisitor::operator()(const DocVerbatim &s)
       break;
     case DocVerbatim::Msc:
       {
-        static int mscindex = 1;
+        static std::atomic<int> mscindex = 1;
         QCString baseName(4096, QCString::ExplicitSize);
 
         baseName.sprintf("%s%d%s",
@@ -682,9 +683,15 @@ void RTFDocVisitor::operator()(const DocAutoList &l)
   if (!l.isCheckedList() && indentLevel()==0) m_t << "\\par\n";
 }
 
+static THREAD_LOCAL int prevLevel = -1;
+static ThreadStateRegistration g_prevLevelState([]()
+{
+  int level = prevLevel;
+  return std::function<void()>([level]() { prevLevel = level; });
+});
+
 void RTFDocVisitor::operator()(const DocAutoListItem &li)
 {
-  static int prevLevel = -1;
   if (m_hide) return;
   DBG_RTF("{\\comment RTFDocVisitor::operator()(const DocAutoListItem &)}\n");
   int level = indentLevel();
@@ -744,7 +751,7 @@ void RTFDocVisitor::operator()(const DocRoot &r)
   if (m_hide) return;
   DBG_RTF("{\\comment RTFDocVisitor::operator()(const DocRoot &)}\n");
   if (r.indent()) incIndentLevel();
-  m_t << "{" << rtf_Style["BodyText"].reference() << "\n";
+  m_t << "{" << rtfStyle("BodyText").reference() << "\n";
   visitChildren(r);
   if (!m_lastIsPara && !r.singleLine()) m_t << "\\par\n";
   m_t << "}";
@@ -759,7 +766,7 @@ void RTFDocVisitor::operator()(const DocSimpleSect &s)
   if (!m_lastIsPara) m_t << "\\par\n";
   m_t << "{"; // start desc
   //m_t << "{\\b "; // start bold
-  m_t << "{" << rtf_Style["Heading5"].reference() << "\n";
+  m_t << "{" << rtfStyle("Heading5").reference() << "\n";
   switch(s.type())
   {
     case DocSimpleSect::See:
@@ -880,7 +887,7 @@ void RTFDocVisitor::operator()(const DocSection &s)
     level = 1;
   heading.sprintf("Heading%d",level);
   // set style
-  m_t << rtf_Style[heading.str()].reference() << "\n";
+  m_t << rtfStyle(heading.str()).reference() << "\n";
   // make table of contents entry
   if (s.title())
   {
@@ -1001,7 +1008,7 @@ void RTFDocVisitor::operator()(const DocHtmlDescTitle &dt)
   DBG_RTF("{\\comment RTFDocVisitor::operator()(const DocHtmlDescTitle &)}\n");
   //m_t << "\\par\n";
   //m_t << "{\\b ";
-  m_t << "{" << rtf_Style["Heading5"].reference() << "\n";
+  m_t << "{" << rtfStyle("Heading5").reference() << "\n";
   m_lastIsPara=FALSE;
   visitChildren(dt);
   m_t << "\\par\n";
@@ -1194,7 +1201,7 @@ void RTFDocVisitor::operator()(const DocHtmlHeader &header)
   int level = std::clamp(header.level()+m_hierarchyLevel,SectionType::MinLevel,SectionType::MaxLevel);
   heading.sprintf("Heading%d",level);
   // set style
-  m_t << rtf_Style[heading.str()].reference();
+  m_t << rtfStyle(heading.str()).reference();
   // make open table of contents entry that will be closed in visitPost method
   m_t << "{\\tc\\tcl" << level << " ";
   m_lastIsPara=FALSE;
@@ -1379,7 +1386,7 @@ void RTFDocVisitor::operator()(const DocParamSect &s)
   m_t << "{"; // start param list
   if (!m_lastIsPara) m_t << "\\par\n";
   //m_t << "{\\b "; // start bold
-  m_t << "{" << rtf_Style["Heading5"].reference() << "\n";
+  m_t << "{" << rtfStyle("Heading5").reference() << "\n";
   switch(s.type())
   {
     case DocParamSect::Param:
@@ -1563,7 +1570,7 @@ void RTFDocVisitor::operator()(const DocXRefItem &x)
   }
   m_t << "{"; // start param list
   //m_t << "{\\b "; // start bold
-  m_t << "{" << rtf_Style["Heading5"].reference() << "\n";
+  m_t << "{" << rtfStyle("Heading5").reference() << "\n";
   if (Config_getBool(RTF_HYPERLINKS) && !anonymousEnum)
   {
     QCString refName;
@@ -280,7 +280,7 @@ void RTFCodeGenerator::endFontClass()
 QCString RTFCodeGenerator::rtf_Code_DepthStyle()
 {
   QCString n=makeIndexName("CodeExample",m_indentLevel);
-  return rtf_Style[n.str()].reference();
+  return rtfStyle(n.str()).reference();
 }
 
 void RTFCodeGenerator::setSourceFileName(const QCString &name)
@@ -306,6 +306,7 @@ RTFGenerator::RTFGenerator(const RTFGenerator &og) : OutputGenerator(og.m_dir),
   m_omitParagraph  = og.m_omitParagraph;
   m_numCols        = og.m_numCols;
   m_relPath        = og.m_relPath;
+  m_hierarchyLevel = og.m_hierarchyLevel;
   m_indentLevel    = og.m_indentLevel;
   m_listItemInfo   = og.m_listItemInfo;
 }
@@ -322,6 +323,7 @@ RTFGenerator &RTFGenerator::operator=(const RTFGenerator &og)
     m_omitParagraph  = og.m_omitParagraph;
     m_numCols        = og.m_numCols;
     m_relPath        = og.m_relPath;
+    m_hierarchyLevel = og.m_hierarchyLevel;
     m_indentLevel    = og.m_indentLevel;
     m_listItemInfo   = og.m_listItemInfo;
   }
@@ -631,7 +633,7 @@ void RTFGenerator::beginRTFChapter()
     m_t << "\\sect\\sbkpage\n";
   //m_t << "\\sect\\sectd\\sbkpage\n";
 
-  m_t << rtf_Style["Heading1"].reference() << "\n";
+  m_t << rtfStyle("Heading1").reference() << "\n";
 }
 
 void RTFGenerator::beginRTFSection()
@@ -652,7 +654,7 @@ void RTFGenerator::beginRTFSection()
   }
   int level = 2 + m_hierarchyLevel;
 
-  m_t << rtf_Style[QCString().sprintf("Heading%d", level).str()].reference() << "\n";
+  m_t << rtfStyle(QCString().sprintf("Heading%d", level).str()).reference() << "\n";
 }
 
 void RTFGenerator::startFile(const QCString &name,const QCString &,const QCString &,int,int hierarchyLevel)
@@ -902,12 +904,12 @@ void RTFGenerator::endIndexSection(IndexSection is)
         m_t << "}";
         m_t << rtf_Style_Reset <<"\n";
         m_t << "\\sectd\\pgnlcrm\n";
-        m_t << "{\\footer "<<rtf_Style["Footer"].reference() << "{\\chpgn}}\n";
+        m_t << "{\\footer "<<rtfStyle("Footer").reference() << "{\\chpgn}}\n";
         // the title entry
         DBG_RTF(m_t << "{\\comment begin title page}\n")
 
 
-        m_t << rtf_Style_Reset << rtf_Style["SubTitle"].reference() << "\n"; // set to title style
+        m_t << rtf_Style_Reset << rtfStyle("SubTitle").reference() << "\n"; // set to title style
 
         m_t << "\\vertalc\\qc\\par\\par\\par\\par\\par\\par\\par\n";
         if (!rtf_logoFilename.isEmpty())
@@ -920,7 +922,7 @@ void RTFGenerator::endIndexSection(IndexSection is)
           m_t << rtf_company << "\\par\\par\n";
         }
 
-        m_t << rtf_Style_Reset << rtf_Style["Title"].reference() << "\n"; // set to title style
+        m_t << rtf_Style_Reset << rtfStyle("Title").reference() << "\n"; // set to title style
         if (!rtf_title.isEmpty())
         {
           // User has overridden document title in extensions file
@@ -938,7 +940,7 @@ void RTFGenerator::endIndexSection(IndexSection is)
           }
         }
 
-        m_t << rtf_Style_Reset << rtf_Style["SubTitle"].reference() << "\n"; // set to title style
+        m_t << rtf_Style_Reset << rtfStyle("SubTitle").reference() << "\n"; // set to title style
         m_t << "\\par\n";
         if (!rtf_documentType.isEmpty())
         {
@@ -950,7 +952,7 @@ void RTFGenerator::endIndexSection(IndexSection is)
         }
         m_t << "\\par\\par\\par\\par\\par\\par\\par\\par\\par\\par\\par\\par\n";
 
-        m_t << rtf_Style_Reset << rtf_Style["SubTitle"].reference() << "\n"; // set to subtitle style
+        m_t << rtf_Style_Reset << rtfStyle("SubTitle").reference() << "\n"; // set to subtitle style
         if (!rtf_author.isEmpty())
         {
           m_t << "{\\field\\fldedit {\\*\\fldinst AUTHOR \\\\*MERGEFORMAT}{\\fldrslt "<< rtf_author << " }}\\par\n";
@@ -982,7 +984,7 @@ void RTFGenerator::endIndexSection(IndexSection is)
         DBG_RTF(m_t << "{\\comment Table of contents}\n")
         m_t << "\\vertalt\n";
         m_t << rtf_Style_Reset << "\n";
-        m_t << rtf_Style["Heading1"].reference();
+        m_t << rtfStyle("Heading1").reference();
         m_t << theTranslator->trRTFTableOfContents() << "\\par\n";
         m_t << rtf_Style_Reset << "\\par\n";
         m_t << "{\\field\\fldedit {\\*\\fldinst TOC \\\\f \\\\*MERGEFORMAT}{\\fldrslt Table of contents}}\\par\n";
@@ -1249,7 +1251,7 @@ void RTFGenerator::endIndexSection(IndexSection is)
       break;
     case IndexSection::isEndIndex:
       beginRTFChapter();
-      m_t << rtf_Style["Heading1"].reference();
+      m_t << rtfStyle("Heading1").reference();
       m_t << theTranslator->trRTFGeneralIndex() << "\\par \n";
       m_t << rtf_Style_Reset << "\n";
       m_t << "{\\tc \\v " << theTranslator->trRTFGeneralIndex() << "}\n";
@@ -1275,7 +1277,7 @@ void RTFGenerator::lastIndexPage()
   m_t << "\\sect \\sectd \\sbknone\n";
 
   // set new footer with arabic numbers
-  m_t << "{\\footer "<< rtf_Style["Footer"].reference() << "{\\chpgn}}\n";
+  m_t << "{\\footer "<< rtfStyle("Footer").reference() << "{\\chpgn}}\n";
 
 }
 
@@ -1460,7 +1462,7 @@ void RTFGenerator::startCompoundTemplateParams()
   DBG_RTF(m_t << "{\\comment Begin SubSubSection}\n")
   m_t << "{\n";
   int level = 4 + m_hierarchyLevel;
-  m_t << rtf_Style_Reset << rtf_Style[QCString().sprintf("Heading%d", level).str()].reference() << "\n";
+  m_t << rtf_Style_Reset << rtfStyle(QCString().sprintf("Heading%d", level).str()).reference() << "\n";
 }
 
 void RTFGenerator::endCompoundTemplateParams()
@@ -1570,7 +1572,7 @@ void RTFGenerator::startTitleHead(const QCString &)
   QCString heading;
   heading.sprintf("Heading%d", level);
   //    beginRTFSection();
-  m_t << rtf_Style_Reset << rtf_Style[heading.str()].reference() << "\n";
+  m_t << rtf_Style_Reset << rtfStyle(heading.str()).reference() << "\n";
 }
 
 void RTFGenerator::endTitleHead(const QCString &fileName,const QCString &name)
@@ -1601,15 +1603,15 @@ void RTFGenerator::startGroupHeader(int extraIndent)
   extraIndent += m_hierarchyLevel;
   if (extraIndent>=2)
   {
-    m_t << rtf_Style["Heading5"].reference();
+    m_t << rtfStyle("Heading5").reference();
   }
   else if (extraIndent==1)
   {
-    m_t << rtf_Style["Heading4"].reference();
+    m_t << rtfStyle("Heading4").reference();
   }
   else // extraIndent==0
   {
-    m_t << rtf_Style["Heading3"].reference();
+    m_t << rtfStyle("Heading3").reference();
   }
   m_t << "\n";
 }
@@ -1643,10 +1645,10 @@ void RTFGenerator::startMemberDoc(const QCString &clname,
     level = 5;
   if (level < 1)
     level = 1;
-  m_t << rtf_Style_Reset << rtf_Style[QCString().sprintf("Heading%d", level).str()].reference();
+  m_t << rtf_Style_Reset << rtfStyle(QCString().sprintf("Heading%d", level).str()).reference();
   //styleStack.push(rtf_Style_Heading4);
   m_t << "{\n";
-  //printf("RTFGenerator::startMemberDoc() '%s'\n",rtf_Style["Heading4"].reference());
+  //printf("RTFGenerator::startMemberDoc() '%s'\n",rtfStyle("Heading4").reference());
   startBold();
   m_t << "\n";
 }
@@ -1656,7 +1658,7 @@ void RTFGenerator::endMemberDoc(bool)
   DBG_RTF(m_t << "{\\comment endMemberDoc}\n")
   //const QCString &style = styleStack.pop();
   //printf("RTFGenerator::endMemberDoc() '%s'\n",style);
-  //ASSERT(style==rtf_Style["Heading4"].reference());
+  //ASSERT(style==rtfStyle("Heading4").reference());
   endBold();
   m_t << "}\n";
   newParagraph();
@@ -1778,7 +1780,7 @@ void RTFGenerator::startSection(const QCString &,const QCString &title,SectionTy
   QCString heading;
   heading.sprintf("Heading%d",num);
   // set style
-  m_t << rtf_Style[heading.str()].reference();
+  m_t << rtfStyle(heading.str()).reference();
   // make table of contents entry
   m_t << "{\\tc\\tcl" << num << " \\v ";
   docify(title);
@@ -1904,7 +1906,7 @@ void RTFGenerator::startDescTable(const QCString &title,const bool hasInits)
 {
   DBG_RTF(m_t << "{\\comment (startDescTable) }\n")
   m_t << "{\\par\n";
-  m_t << "{" << rtf_Style["Heading5"].reference() << "\n";
+  m_t << "{" << rtfStyle("Heading5").reference() << "\n";
   docify(title);
   m_t << ":\\par}\n";
   m_t << rtf_Style_Reset << rtf_DList_DepthStyle();
@@ -1947,7 +1949,7 @@ void RTFGenerator::startDescTableTitle()
 {
   DBG_RTF(m_t << "{\\comment (startDescTableTitle) }\n")
   m_t << "{";
-  m_t << rtf_Style["BodyText"].reference();
+  m_t << rtfStyle("BodyText").reference();
 }
 
 void RTFGenerator::endDescTableTitle()
@@ -1960,7 +1962,7 @@ void RTFGenerator::startDescTableInit()
 {
   DBG_RTF(m_t << "{\\comment (startDescTableInit) }"    << endl)
   m_t << "{";
-  m_t << rtf_Style["BodyText"].reference();
+  m_t << rtfStyle("BodyText").reference();
   m_t << "\\qr ";
 }
 
@@ -2015,34 +2017,34 @@ void RTFGenerator::decIndentLevel()
 QCString RTFGenerator::rtf_CList_DepthStyle()
 {
   QCString n=makeIndexName("ListContinue",indentLevel());
-  return rtf_Style[n.str()].reference();
+  return rtfStyle(n.str()).reference();
 }
 
 // a style for list formatted as a "latext style" table of contents
 QCString RTFGenerator::rtf_LCList_DepthStyle()
 {
   QCString n=makeIndexName("LatexTOC",indentLevel());
-  return rtf_Style[n.str()].reference();
+  return rtfStyle(n.str()).reference();
 }
 
 // a style for list formatted as a "bullet" style
 QCString RTFGenerator::rtf_BList_DepthStyle()
 {
   QCString n=makeIndexName("ListBullet",indentLevel());
-  return rtf_Style[n.str()].reference();
+  return rtfStyle(n.str()).reference();
 }
 
 // a style for list formatted as a "enumeration" style
 QCString RTFGenerator::rtf_EList_DepthStyle()
 {
   QCString n=makeIndexName("ListEnum",indentLevel());
-  return rtf_Style[n.str()].reference();
+  return rtfStyle(n.str()).reference();
 }
 
 QCString RTFGenerator::rtf_DList_DepthStyle()
 {
   QCString n=makeIndexName("DescContinue",indentLevel());
-  return rtf_Style[n.str()].reference();
+  return rtfStyle(n.str()).reference();
 }
 
 void RTFGenerator::startTextBlock(bool dense)
@@ -2052,11 +2054,11 @@ void RTFGenerator::startTextBlock(bool dense)
   m_t << rtf_Style_Reset;
   if (dense) // no spacing between "paragraphs"
   {
-    m_t << rtf_Style["DenseText"].reference();
+    m_t << rtfStyle("DenseText").reference();
   }
   else // some spacing
   {
-    m_t << rtf_Style["BodyText"].reference();
+    m_t << rtfStyle("BodyText").reference();
   }
 }
 
@@ -2481,7 +2483,7 @@ void RTFGenerator::startMemberGroupHeader(bool hasHeader)
   DBG_RTF(m_t << "{\\comment startMemberGroupHeader}\n")
   m_t << "{\n";
   if (hasHeader) incIndentLevel();
-  m_t << rtf_Style_Reset << rtf_Style["GroupHeader"].reference();
+  m_t << rtf_Style_Reset << rtfStyle("GroupHeader").reference();
 }
 
 void RTFGenerator::endMemberGroupHeader()
@@ -2682,7 +2684,7 @@ void RTFGenerator::startInlineHeader()
 {
   DBG_RTF(m_t << "{\\comment (startInlineHeader)}\n")
   m_t << "{\n";
-  m_t << rtf_Style_Reset << rtf_Style["Heading5"].reference();
+  m_t << rtf_Style_Reset << rtfStyle("Heading5").reference();
   startBold();
 }
 
@@ -2698,7 +2700,7 @@ void RTFGenerator::startMemberDocSimple(bool isEnum)
 {
   DBG_RTF(m_t << "{\\comment (startMemberDocSimple)}\n")
   m_t << "{\\par\n";
-  m_t << "{" << rtf_Style["Heading5"].reference() << "\n";
+  m_t << "{" << rtfStyle("Heading5").reference() << "\n";
   if (isEnum)
   {
     m_t << theTranslator->trEnumerationValues();
@@ -2797,7 +2799,7 @@ void RTFGenerator::writeInheritedSectionTitle(
                   const QCString &title, const QCString &name)
 {
   m_t << rtf_Style_Reset;
-  m_t << rtf_Style["Heading4"].reference();
+  m_t << rtfStyle("Heading4").reference();
   m_t << "\n";
   m_t << theTranslator->trInheritedFrom(docifyToString(title), objectLinkToString(ref, file, anchor, name));
   m_t << "\\par\n";
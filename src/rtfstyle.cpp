@@ -361,6 +361,13 @@ void loadStylesheet(const QCString &name, StyleDataMap& map)
 
 StyleDataMap rtf_Style;
 
+const StyleData &rtfStyle(const std::string &name)
+{
+  static const StyleData emptyStyle;
+  auto it = rtf_Style.find(name);
+  return it!=rtf_Style.end() ? it->second : emptyStyle;
+}
+
 void loadExtensions(const QCString &name)
 {
   std::ifstream file(name.str());
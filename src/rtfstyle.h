@@ -80,6 +80,12 @@ using StyleDataMap = std::map<std::string,StyleData>;
 
 extern StyleDataMap rtf_Style;
 
+/** Returns the style \a name from rtf_Style, or an empty style if it is not defined.
+ *  Unlike rtf_Style[name] this never modifies the map, so it is safe to use while
+ *  generating output from multiple threads.
+ */
+const StyleData &rtfStyle(const std::string &name);
+
 void loadExtensions(const QCString &name);
 void loadStylesheet(const QCString &name, StyleDataMap& map);
 
@@ -32,6 +32,7 @@
 #include "groupdef.h"
 #include "filedef.h"
 #include "portable.h"
+#include "threadpool.h"
 
 
 // file format: (all multi-byte values are stored in big endian format)
@@ -49,6 +50,21 @@ const size_t numIndexEntries = 256*256;
 
 static std::mutex g_searchIndexMutex;
 
+// The document that words are added to is kept per thread, since documentation
+// for different pages is generated in parallel.
+static thread_local int g_urlIndex = -1;
+static thread_local SearchIndexExternal::SearchDocEntry *g_currentDoc = nullptr;
+static ThreadStateRegistration g_currentDocState([]()
+{
+  int urlIndex = g_urlIndex;
+  SearchIndexExternal::SearchDocEntry *doc = g_currentDoc;
+  return std::function<void()>([urlIndex,doc]()
+  {
+    g_urlIndex = urlIndex;
+    g_currentDoc = doc;
+  });
+});
+
 //--------------------------------------------------------------------
 
 void SearchIndex::IndexWord::addUrlIndex(int idx,bool hiPriority)
@@ -161,13 +177,13 @@ void SearchIndex::setCurrentDoc(const Definition *ctx,const QCString &anchor,boo
   auto it = m_url2IdMap.find(baseUrl.str());
   if (it == m_url2IdMap.end()) // new entry
   {
-    m_urlIndex = m_urlMaxIndex++;
-    m_url2IdMap.emplace(baseUrl.str(),m_urlIndex);
-    m_urls.emplace(m_urlIndex,URL(name,url));
+    g_urlIndex = m_urlMaxIndex++;
+    m_url2IdMap.emplace(baseUrl.str(),g_urlIndex);
+    m_urls.emplace(g_urlIndex,URL(name,url));
   }
   else // existing entry
   {
-    m_urlIndex=it->second;
+    g_urlIndex=it->second;
     m_urls.emplace(it->second,URL(name,url));
   }
 }
@@ -206,7 +222,7 @@ void SearchIndex::addWordRec(const QCString &word,bool hiPriority,bool recurse)
     m_index[idx].emplace_back(wStr);
     it = m_words.emplace( wStr.str(), static_cast<int>(m_index[idx].size())-1 ).first;
   }
-  m_index[idx][it->second].addUrlIndex(m_urlIndex,hiPriority);
+  m_index[idx][it->second].addUrlIndex(g_urlIndex,hiPriority);
   bool found=FALSE;
   if (!recurse) // the first time we check if we can strip the prefix
   {
@@ -487,14 +503,14 @@ void SearchIndexExternal::setCurrentDoc(const Definition *ctx,const QCString &an
     it = m_docEntries.emplace(key.str(),e).first;
     //printf("searchIndexExt %s : %s\n",qPrint(e->name),qPrint(e->url));
   }
-  m_current = &it->second;
+  g_currentDoc = &it->second;
 }
 
 void SearchIndexExternal::addWord(const QCString &word,bool hiPriority)
 {
   std::lock_guard<std::mutex> lock(g_searchIndexMutex);
-  if (word.isEmpty() || !isId(word[0]) || m_current==nullptr) return;
-  GrowBuf *pText = hiPriority ? &m_current->importantText : &m_current->normalText;
+  if (word.isEmpty() || !isId(word[0]) || g_currentDoc==nullptr) return;
+  GrowBuf *pText = hiPriority ? &g_currentDoc->importantText : &g_currentDoc->normalText;
   if (pText->getPos()>0) pText->addChar(' ');
   pText->addStr(word);
   //printf("addWord %s\n",word);
@@ -103,7 +103,6 @@ class SearchIndex
     std::vector< std::vector< IndexWord> > m_index;
     std::unordered_map<std::string,int> m_url2IdMap;
     std::map<int,URL> m_urls;
-    int m_urlIndex = -1;
     int m_urlMaxIndex = 0;
 };
 
@@ -112,6 +111,7 @@ class SearchIndex
  */
 class SearchIndexExternal
 {
+  public:
     struct SearchDocEntry
     {
       QCString type;
@@ -123,14 +123,12 @@ class SearchIndexExternal
       GrowBuf  normalText;
     };
 
-  public:
     SearchIndexExternal();
     void setCurrentDoc(const Definition *ctx,const QCString &anchor,bool isSourceFile);
     void addWord(const QCString &word,bool hiPriority);
     void write(const QCString &file);
   private:
     std::map<std::string,SearchDocEntry> m_docEntries;
-    SearchDocEntry *m_current = nullptr;
 };
 
 /** Abstract proxy interface for non-javascript based search indices.
@@ -773,7 +773,7 @@ void writeJavaScriptSearchIndex()
   std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
   if (numThreads>1) // multi threaded version
   {
-    ThreadPool threadPool(numThreads);
+    ThreadPool threadPool(numThreads,"searchindex");
     std::vector< std::future<int> > results;
     for (auto &sii : g_searchIndexInfo)
     {
@@ -794,7 +794,7 @@ void writeJavaScriptSearchIndex()
       }
     }
     // wait for the results
-    for (auto &f : results) f.get();
+    for (auto &f : results) threadPool.wait(f);
   }
   else // single threaded version
   {
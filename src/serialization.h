@@ -0,0 +1,145 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef SERIALIZATION_H
+#define SERIALIZATION_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "qcstring.h"
+
+/** @brief Writes values into a compact binary buffer.
+ *
+ *  The format uses the native byte order and is only intended for caches
+ *  that are read back by the same doxygen binary on the same machine.
+ *  Readers should therefore always store and check a format version.
+ *
+ *  @see Deserializer
+ */
+class Serializer
+{
+  public:
+    void writeBool(bool b)                  { m_data.push_back(b ? '\1' : '\0'); }
+    void writeInt(int v)                    { writeRaw(static_cast<int32_t>(v));  }
+    void writeUInt(uint32_t v)              { writeRaw(v); }
+    void writeUInt64(uint64_t v)            { writeRaw(v); }
+    void writeString(const std::string &s)  { writeSize(s.size()); m_data.append(s); }
+    void writeString(const QCString &s)     { writeSize(s.length()); m_data.append(s.data(),s.length()); }
+    void writeSize(size_t n)                { writeUInt64(static_cast<uint64_t>(n)); }
+
+    template<class E>
+    void writeEnum(E e)
+    {
+      static_assert(std::is_enum<E>::value,"writeEnum requires an enum type");
+      writeInt(static_cast<int>(e));
+    }
+
+    //! Writes the bytes of a trivially copyable value, such as a bit field wrapper.
+    template<class T>
+    void writeRaw(const T &v)
+    {
+      static_assert(std::is_trivially_copyable<T>::value,"writeRaw requires a trivially copyable type");
+      m_data.append(reinterpret_cast<const char *>(&v),sizeof(T));
+    }
+
+    const std::string &data() const { return m_data; }
+
+  private:
+    std::string m_data;
+};
+
+/** @brief Reads values written by a Serializer.
+ *
+ *  Reading past the end of the buffer does not crash, but puts the
+ *  deserializer in a failed state and returns default values from then on.
+ *  Callers are expected to check failed() once after reading everything.
+ */
+class Deserializer
+{
+  public:
+    explicit Deserializer(const std::string &data) : m_data(data) {}
+
+    bool     readBool()     { char c=0; readBytes(&c,1); return c!=0; }
+    int      readInt()      { int32_t v=0; readRaw(v); return static_cast<int>(v); }
+    uint32_t readUInt()     { uint32_t v=0; readRaw(v); return v; }
+    uint64_t readUInt64()   { uint64_t v=0; readRaw(v); return v; }
+    size_t   readSize()     { return static_cast<size_t>(readUInt64()); }
+    std::string readString()
+    {
+      size_t n = readSize();
+      if (!canRead(n)) return std::string();
+      std::string result = m_data.substr(m_pos,n);
+      m_pos+=n;
+      return result;
+    }
+    QCString readQCString()
+    {
+      size_t n = readSize();
+      if (!canRead(n)) return QCString();
+      QCString result(std::string_view(m_data.data()+m_pos,n));
+      m_pos+=n;
+      return result;
+    }
+
+    template<class E>
+    E readEnum()
+    {
+      static_assert(std::is_enum<E>::value,"readEnum requires an enum type");
+      return static_cast<E>(readInt());
+    }
+
+    template<class T>
+    void readRaw(T &v)
+    {
+      static_assert(std::is_trivially_copyable<T>::value,"readRaw requires a trivially copyable type");
+      readBytes(reinterpret_cast<char *>(&v),sizeof(T));
+    }
+
+    //! Returns TRUE if an attempt was made to read beyond the end of the data.
+    bool failed() const  { return m_failed; }
+    //! Returns TRUE if all data has been consumed.
+    bool atEnd() const   { return m_pos==m_data.size(); }
+    //! Marks the data as invalid, for instance when a value is out of range.
+    void setFailed()     { m_failed=true; }
+
+  private:
+    bool canRead(size_t n)
+    {
+      if (m_failed || n>m_data.size()-m_pos)
+      {
+        m_failed=true;
+        return false;
+      }
+      return true;
+    }
+    void readBytes(char *dst,size_t n)
+    {
+      if (canRead(n))
+      {
+        std::memcpy(dst,m_data.data()+m_pos,n);
+        m_pos+=n;
+      }
+    }
+
+    const std::string &m_data;
+    size_t m_pos = 0;
+    bool m_failed = false;
+};
+
+#endif
@@ -139,7 +139,7 @@ static STLInfo g_stlinfo[] =
 
 static void addSTLMember(const std::shared_ptr<Entry> &root,const char *type,const char *name)
 {
-  std::shared_ptr<Entry> memEntry = std::make_shared<Entry>();
+  std::shared_ptr<Entry> memEntry = makeEntry();
   memEntry->name       = name;
   memEntry->type       = type;
   memEntry->protection = Protection::Public;
@@ -152,7 +152,7 @@ static void addSTLMember(const std::shared_ptr<Entry> &root,const char *type,con
 
 static void addSTLIterator(const std::shared_ptr<Entry> &classEntry,const QCString &name)
 {
-  std::shared_ptr<Entry> iteratorClassEntry = std::make_shared<Entry>();
+  std::shared_ptr<Entry> iteratorClassEntry = makeEntry();
   iteratorClassEntry->fileName  = "[STL]";
   iteratorClassEntry->startLine = 1;
   iteratorClassEntry->name      = name;
@@ -170,7 +170,7 @@ static void addSTLClass(const std::shared_ptr<Entry> &root,const STLInfo *info)
   fullName.prepend("std::");
 
   // add fake Entry for the class
-  std::shared_ptr<Entry> classEntry = std::make_shared<Entry>();
+  std::shared_ptr<Entry> classEntry = makeEntry();
   classEntry->fileName  = "[STL]";
   classEntry->startLine = 1;
   classEntry->name      = fullName;
@@ -210,7 +210,7 @@ static void addSTLClass(const std::shared_ptr<Entry> &root,const STLInfo *info)
       fullName=="std::weak_ptr" ||
       fullName=="std::unique_ptr")
   {
-    std::shared_ptr<Entry> memEntry = std::make_shared<Entry>();
+    std::shared_ptr<Entry> memEntry = makeEntry();
     memEntry->name       = "operator->";
     memEntry->args       = "()";
     memEntry->type       = "T*";
@@ -244,7 +244,7 @@ static void addSTLClass(const std::shared_ptr<Entry> &root,const STLInfo *info)
 
 static void addSTLClasses(const std::shared_ptr<Entry> &root)
 {
-  std::shared_ptr<Entry> namespaceEntry = std::make_shared<Entry>();
+  std::shared_ptr<Entry> namespaceEntry = makeEntry();
   namespaceEntry->fileName  = "[STL]";
   namespaceEntry->startLine = 1;
   namespaceEntry->name      = "std";
@@ -0,0 +1,94 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#ifndef STREAMPIPE_H
+#define STREAMPIPE_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "construct.h"
+
+/** @brief Bounded buffer passing a stream of characters from one thread to another.
+ *
+ *  The producer calls write() for each piece of output and close() when done.
+ *  The consumer calls read() until it returns 0. A writer blocks while the
+ *  buffer holds \a capacity bytes or more, so at most about \a capacity bytes
+ *  are in transit, independent of the total size of the stream.
+ */
+class StreamPipe
+{
+  public:
+    explicit StreamPipe(size_t capacity) : m_capacity(capacity) {}
+    NON_COPYABLE(StreamPipe)
+
+    /** Appends \a data to the stream, waiting for the reader if the buffer is full. */
+    void write(std::string_view data)
+    {
+      if (data.empty()) return;
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_notFull.wait(lock,[this]() { return size()<m_capacity; });
+      if (m_readPos>0 && m_readPos>=m_buf.size()/2) // reclaim space that was already read
+      {
+        m_buf.erase(0,m_readPos);
+        m_readPos=0;
+      }
+      m_buf.append(data);
+      lock.unlock();
+      m_notEmpty.notify_one();
+    }
+
+    /** Marks the end of the stream, after this no more data can be written. */
+    void close()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+      }
+      m_notEmpty.notify_one();
+    }
+
+    /** Copies at most \a maxSize bytes of the stream to \a buf and returns the number of
+     *  bytes copied. Waits until data is available, returns 0 at the end of the stream.
+     */
+    size_t read(char *buf,size_t maxSize)
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_notEmpty.wait(lock,[this]() { return size()>0 || m_closed; });
+      size_t n = std::min(maxSize,size());
+      memcpy(buf,m_buf.data()+m_readPos,n);
+      m_readPos+=n;
+      lock.unlock();
+      m_notFull.notify_one();
+      return n;
+    }
+
+  private:
+    size_t size() const { return m_buf.size()-m_readPos; }
+
+    const size_t m_capacity;
+    std::mutex m_mutex;
+    std::condition_variable m_notFull;
+    std::condition_variable m_notEmpty;
+    std::string m_buf;
+    size_t m_readPos = 0;
+    bool m_closed = false;
+};
+
+#endif
@@ -23,38 +23,53 @@
 #include <utility>
 #include <cassert>
 
+#include "atom.h"
+
 //! Class implementing a symbol map that maps symbol names to objects.
 //! Symbol names do not have to be unique.
 //! Supports adding symbols with add(), removing symbols with remove(), and
 //! finding symbols with find().
+//! Symbol names are stored as atoms, so a lookup hashes and compares small integers.
 template<class T>
 class SymbolMap
 {
   public:
     using Ptr = T *;
     using VectorPtr = std::vector<Ptr>;
-    using Map = std::unordered_map<std::string,VectorPtr>;
+    using Map = std::unordered_map<Atom,VectorPtr>;
     using iterator = typename Map::iterator;
     using const_iterator = typename Map::const_iterator;
 
     //! Add a symbol \a def into the map under key \a name
     void add(const QCString &name,Ptr def)
     {
-      auto it = m_map.find(name.str());
+      add(Atom(name),def);
+    }
+
+    //! Add a symbol \a def into the map under key \a name
+    void add(Atom name,Ptr def)
+    {
+      auto it = m_map.find(name);
       if (it!=m_map.end())
       {
         it->second.push_back(def);
       }
       else
       {
-        m_map.emplace(name.str(),VectorPtr({def}));
+        m_map.emplace(name,VectorPtr({def}));
       }
     }
 
     //! Remove a symbol \a def from the map that was stored under key \a name
     void remove(const QCString &name,Ptr def)
     {
-      auto it1 = m_map.find(name.str());
+      remove(Atom::find(name),def);
+    }
+
+    //! Remove a symbol \a def from the map that was stored under key \a name
+    void remove(Atom name,Ptr def)
+    {
+      auto it1 = m_map.find(name);
       if (it1!=m_map.end())
       {
         VectorPtr &v = it1->second;
@@ -73,9 +88,16 @@ class SymbolMap
     //! Find the list of symbols stored under key \a name
     //! Returns a pair of iterators pointing to the start and end of the range of matching symbols
     const VectorPtr &find(const QCString &name)
+    {
+      return find(Atom::find(name));
+    }
+
+    //! Find the list of symbols stored under key \a name
+    const VectorPtr &find(Atom name)
     {
       assert(m_noMatch.empty());
-      auto it = m_map.find(name.str());
+      if (!name.isValid()) return m_noMatch; // name was never interned, so it cannot be in the map
+      auto it = m_map.find(name);
       return it==m_map.end() ? m_noMatch : it->second;
     }
 
@@ -84,6 +106,7 @@ class SymbolMap
     const_iterator begin() const { return m_map.cbegin(); }
     const_iterator end() const   { return m_map.cend();   }
     bool empty() const           { return m_map.empty();  }
+    size_t size() const          { return m_map.size();   }
 
   private:
     Map m_map;
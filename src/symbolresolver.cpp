@@ -14,6 +14,7 @@
  */
 
 #include <unordered_map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -34,7 +35,6 @@
 #define AUTO_TRACE_EXIT(...) (void)0
 #endif
 
-static std::mutex g_cacheMutex;
 static std::recursive_mutex g_cacheTypedefMutex;
 
 //--------------------------------------------------------------------------------------
@@ -308,12 +308,8 @@ const ClassDef *SymbolResolver::Private::getResolvedTypeRec(
     // remember the key
     visitedKeys.push_back(key.str());
 
-    LookupInfo *pval = nullptr;
-    {
-      std::lock_guard lock(g_cacheMutex);
-      pval = Doxygen::typeLookupCache->find(key.str());
-    }
-    AUTO_TRACE_ADD("key={} found={}",key,pval!=nullptr);
+    std::optional<LookupInfo> pval = Doxygen::typeLookupCache->find(key.view());
+    AUTO_TRACE_ADD("key={} found={}",key,pval.has_value());
     if (pval)
     {
       if (pTemplSpec)    *pTemplSpec=pval->templSpec;
@@ -353,11 +349,8 @@ const ClassDef *SymbolResolver::Private::getResolvedTypeRec(
       *pResolvedType = bestResolvedType;
     }
 
-    {
-      std::lock_guard lock(g_cacheMutex);
-      Doxygen::typeLookupCache->insert(key.str(),
-                            LookupInfo(bestMatch,bestTypedef,bestTemplSpec,bestResolvedType));
-    }
+    Doxygen::typeLookupCache->insert(key.view(),
+                          LookupInfo(bestMatch,bestTypedef,bestTemplSpec,bestResolvedType));
     visitedKeys.erase(std::remove(visitedKeys.begin(), visitedKeys.end(), key.str()), visitedKeys.end());
 
     AUTO_TRACE_EXIT("found name={} templSpec={} typeDef={} resolvedTypedef={}",
@@ -477,12 +470,8 @@ const Definition *SymbolResolver::Private::getResolvedSymbolRec(
     }
     // remember the key
     visitedKeys.push_back(key);
-    LookupInfo *pval = nullptr;
-    {
-      std::lock_guard lock(g_cacheMutex);
-      pval = Doxygen::symbolLookupCache->find(key);
-    }
-    AUTO_TRACE_ADD("key={} found={}",key,pval!=nullptr);
+    std::optional<LookupInfo> pval = Doxygen::symbolLookupCache->find(key);
+    AUTO_TRACE_ADD("key={} found={}",key,pval.has_value());
     if (pval)
     {
       if (pTemplSpec)    *pTemplSpec=pval->templSpec;
@@ -533,12 +522,7 @@ const Definition *SymbolResolver::Private::getResolvedSymbolRec(
       *pResolvedType = bestResolvedType;
     }
 
-    {
-      LookupInfo lookupInfo(bestMatch,bestTypedef,bestTemplSpec,bestResolvedType);
-      std::lock_guard lock(g_cacheMutex);
-      // we need to insert the item in the cache again, as it could be removed in the meantime
-      Doxygen::symbolLookupCache->insert(key,std::move(lookupInfo));
-    }
+    Doxygen::symbolLookupCache->insert(key,LookupInfo(bestMatch,bestTypedef,bestTemplSpec,bestResolvedType));
     visitedKeys.erase(std::remove(visitedKeys.begin(),visitedKeys.end(),key),visitedKeys.end());
 
     AUTO_TRACE_EXIT("found name={} templSpec={} typeDef={} resolvedTypedef={}",
@@ -1382,7 +1382,7 @@ void TagFileParser::buildMemberList(const std::shared_ptr<Entry> &ce,const std::
 {
   for (const auto &tmi : members)
   {
-    std::shared_ptr<Entry> me = std::make_shared<Entry>();
+    std::shared_ptr<Entry> me = makeEntry();
     me->type       = tmi.type;
     me->name       = tmi.name;
     me->args       = tmi.arglist;
@@ -1395,7 +1395,7 @@ void TagFileParser::buildMemberList(const std::shared_ptr<Entry> &ce,const std::
       me->spec.setStrong(true);
       for (const auto &evi : tmi.enumValues)
       {
-        std::shared_ptr<Entry> ev = std::make_shared<Entry>();
+        std::shared_ptr<Entry> ev = makeEntry();
         ev->type       = "@";
         ev->name       = evi.name;
         ev->id         = evi.clangid;
@@ -1505,7 +1505,7 @@ void TagFileParser::buildLists(const std::shared_ptr<Entry> &root)
     const TagClassInfo *tci = comp.getClassInfo();
     if (tci)
     {
-      std::shared_ptr<Entry> ce = std::make_shared<Entry>();
+      std::shared_ptr<Entry> ce = makeEntry();
       ce->section = EntryType::makeClass();
       switch (tci->kind)
       {
@@ -1563,7 +1563,7 @@ void TagFileParser::buildLists(const std::shared_ptr<Entry> &root)
     const TagFileInfo *tfi = comp.getFileInfo();
     if (tfi)
     {
-      std::shared_ptr<Entry> fe = std::make_shared<Entry>();
+      std::shared_ptr<Entry> fe = makeEntry();
       fe->section = guessSection(tfi->name);
       fe->name     = tfi->name;
       addDocAnchors(fe,tfi->docAnchors);
@@ -1598,7 +1598,7 @@ void TagFileParser::buildLists(const std::shared_ptr<Entry> &root)
     const TagConceptInfo *tci = comp.getConceptInfo();
     if (tci)
     {
-      std::shared_ptr<Entry> ce = std::make_shared<Entry>();
+      std::shared_ptr<Entry> ce = makeEntry();
       ce->section = EntryType::makeConcept();
       ce->name     = tci->name;
       addDocAnchors(ce,tci->docAnchors);
@@ -1655,7 +1655,7 @@ void TagFileParser::buildLists(const std::shared_ptr<Entry> &root)
     const TagNamespaceInfo *tni = comp.getNamespaceInfo();
     if (tni)
     {
-      std::shared_ptr<Entry> ne = std::make_shared<Entry>();
+      std::shared_ptr<Entry> ne = makeEntry();
       ne->section = EntryType::makeNamespace();
       ne->name     = tni->name;
       addDocAnchors(ne,tni->docAnchors);
@@ -1677,7 +1677,7 @@ void TagFileParser::buildLists(const std::shared_ptr<Entry> &root)
     const TagPackageInfo *tpgi = comp.getPackageInfo();
     if (tpgi)
     {
-      std::shared_ptr<Entry> pe = std::make_shared<Entry>();
+      std::shared_ptr<Entry> pe = makeEntry();
       pe->section = EntryType::makePackage();
       pe->name     = tpgi->name;
       addDocAnchors(pe,tpgi->docAnchors);
@@ -1698,7 +1698,7 @@ void TagFileParser::buildLists(const std::shared_ptr<Entry> &root)
     const TagGroupInfo *tgi = comp.getGroupInfo();
     if (tgi)
     {
-      std::shared_ptr<Entry> ge = std::make_shared<Entry>();
+      std::shared_ptr<Entry> ge = makeEntry();
       ge->section = EntryType::makeGroupDoc();
       ge->name     = tgi->name;
       ge->type     = tgi->title;
@@ -1739,7 +1739,7 @@ void TagFileParser::buildLists(const std::shared_ptr<Entry> &root)
     const TagPageInfo *tpi = comp.getPageInfo();
     if (tpi)
     {
-      std::shared_ptr<Entry> pe = std::make_shared<Entry>();
+      std::shared_ptr<Entry> pe = makeEntry();
       bool isIndex = (stripExtensionGeneral(tpi->filename,getFileNameExtension(tpi->filename))=="index");
       pe->section  = isIndex ? EntryType::makeMainpageDoc() : EntryType::makePageDoc();
       pe->name     = tpi->name;
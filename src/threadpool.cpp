@@ -0,0 +1,252 @@
+/******************************************************************************
+ *
+ * Copyright (C) 1997-2024 by Dimitri van Heesch.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation under the terms of the GNU General Public License is hereby
+ * granted. No representations are made about the suitability of this software
+ * for any purpose. It is provided "as is" without express or implied warranty.
+ * See the GNU General Public License for more details.
+ *
+ * Documents produced by Doxygen are derivative works derived from the
+ * input used in their production; they are not affected by this license.
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "threadpool.h"
+
+static constexpr std::size_t g_maxWorkers    = 256;
+static constexpr std::size_t g_numPriorities = 3;
+
+// index of the worker running on this thread, or -1 for other threads
+static thread_local int t_workerIndex = -1;
+
+/** A queued task together with the group it belongs to */
+struct QueuedTask
+{
+  TaskScheduler::Task task;
+  TaskScheduler::TaskGroup group;
+};
+
+/** Tasks queued for a single worker, one deque per priority */
+struct WorkerQueue
+{
+  std::mutex mutex;
+  std::array<std::deque<QueuedTask>,g_numPriorities> tasks;
+};
+
+struct TaskScheduler::Private
+{
+  // The queues are never moved or deleted, so other workers can access
+  // the first numWorkers entries without holding workersMutex.
+  std::array<std::unique_ptr<WorkerQueue>,g_maxWorkers> queues;
+  std::atomic<std::size_t> numWorkers = 0;
+  std::mutex workersMutex;
+  std::vector<std::thread> threads;
+
+  std::atomic<std::size_t> numPending = 0;  // number of queued tasks not yet picked up
+  std::atomic<std::size_t> numSubmitted = 0;// number of tasks queued so far
+  std::atomic<std::size_t> nextQueue = 0;   // round robin index for tasks from non-worker threads
+
+  // sleeping workers wait for sleepCond, threads waiting for a result wait for doneCond
+  std::mutex sleepMutex;
+  std::condition_variable sleepCond;
+  std::mutex doneMutex;
+  std::condition_variable doneCond;
+  std::atomic<std::size_t> numHelpersWaiting = 0; // waiting workers that also need to know about new tasks
+
+  // thread local state saved and restored around tasks run by a waiting thread
+  std::vector<SaveStateFunc> threadState;
+
+  void notifyDone()
+  {
+    {
+      std::lock_guard<std::mutex> lock(doneMutex);
+    }
+    doneCond.notify_all();
+  }
+
+  // takes the newest or oldest task of the highest priority from queue \a index,
+  // only considering tasks whose group is accepted by \a filter, if set
+  bool popTask(std::size_t index,bool newest,const HelpFilter &filter,Task &task)
+  {
+    WorkerQueue &wq = *queues[index];
+    std::lock_guard<std::mutex> lock(wq.mutex);
+    for (std::size_t prio=g_numPriorities; prio-- > 0; )
+    {
+      auto &dq = wq.tasks[prio];
+      auto accepted = [&filter](const QueuedTask &qt) { return !filter || filter(qt.group); };
+      auto it = dq.end();
+      if (newest)
+      {
+        auto rit = std::find_if(dq.rbegin(),dq.rend(),accepted);
+        if (rit!=dq.rend()) it = std::prev(rit.base());
+      }
+      else
+      {
+        it = std::find_if(dq.begin(),dq.end(),accepted);
+      }
+      if (it!=dq.end())
+      {
+        task = std::move(it->task);
+        dq.erase(it);
+        numPending--;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // takes a task from the own queue, or steals one from the other workers
+  bool findTask(const HelpFilter &filter,Task &task)
+  {
+    std::size_t n = numWorkers;
+    std::size_t self = t_workerIndex>=0 ? static_cast<std::size_t>(t_workerIndex) : 0;
+    if (t_workerIndex>=0 && popTask(self,true,filter,task)) return true;
+    for (std::size_t i=1; i<=n; i++)
+    {
+      if (popTask((self+i)%n,false,filter,task)) return true;
+    }
+    return false;
+  }
+
+  void runTask(Task &task)
+  {
+    task();
+    task = nullptr;
+    notifyDone();
+  }
+
+  void workerLoop(std::size_t index)
+  {
+    t_workerIndex = static_cast<int>(index);
+    ChromeTrace::instance().setThreadName("worker #"+QCString().setNum(index));
+    Task task;
+    while (true)
+    {
+      if (findTask(HelpFilter(),task))
+      {
+        runTask(task);
+      }
+      else
+      {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCond.wait(lock,[this]() { return numPending>0; });
+      }
+    }
+  }
+};
+
+TaskScheduler::TaskScheduler() : p(std::make_unique<Private>())
+{
+}
+
+TaskScheduler::~TaskScheduler() = default;
+
+TaskScheduler &TaskScheduler::instance()
+{
+  // Intentionally never destroyed: the workers may still be running when
+  // the process exits, e.g. when exit() is called from within a task.
+  static TaskScheduler *scheduler = new TaskScheduler;
+  return *scheduler;
+}
+
+void TaskScheduler::reserve(std::size_t numWorkers)
+{
+  std::lock_guard<std::mutex> lock(p->workersMutex);
+  numWorkers = std::min(numWorkers,g_maxWorkers);
+  for (std::size_t i=p->numWorkers; i<numWorkers; i++)
+  {
+    p->queues[i] = std::make_unique<WorkerQueue>();
+    p->numWorkers++; // publish the queue before starting the thread
+    p->threads.emplace_back([this,i]() { p->workerLoop(i); });
+  }
+}
+
+void TaskScheduler::submit(Task &&task,TaskPriority priority,TaskGroup group)
+{
+  if (p->numWorkers==0) reserve(1);
+  std::size_t index = t_workerIndex>=0 ? static_cast<std::size_t>(t_workerIndex)
+                                       : p->nextQueue++ % p->numWorkers;
+  {
+    WorkerQueue &wq = *p->queues[index];
+    std::lock_guard<std::mutex> lock(wq.mutex);
+    wq.tasks[static_cast<std::size_t>(priority)].push_back(QueuedTask{std::move(task),group});
+    p->numPending++;
+    p->numSubmitted++;
+  }
+  {
+    std::lock_guard<std::mutex> lock(p->sleepMutex);
+  }
+  p->sleepCond.notify_one();
+  if (p->numHelpersWaiting>0) // a waiting worker may be able to run the task as well
+  {
+    p->notifyDone();
+  }
+}
+
+void TaskScheduler::registerThreadState(SaveStateFunc save)
+{
+  p->threadState.push_back(std::move(save));
+}
+
+bool TaskScheduler::runPendingTask(const HelpFilter &filter)
+{
+  Task task;
+  if (p->findTask(filter,task))
+  {
+    std::vector<std::function<void()>> restore;
+    restore.reserve(p->threadState.size());
+    for (const auto &save : p->threadState)
+    {
+      restore.push_back(save());
+    }
+    p->runTask(task);
+    for (const auto &r : restore)
+    {
+      r();
+    }
+    return true;
+  }
+  return false;
+}
+
+bool TaskScheduler::isWorkerThread()
+{
+  return t_workerIndex>=0;
+}
+
+std::size_t TaskScheduler::numSubmitted() const
+{
+  return p->numSubmitted;
+}
+
+void TaskScheduler::idleWait(const std::function<bool()> &ready,bool helping,std::size_t submitted)
+{
+  // every finished task notifies doneCond, and so does every new task when a worker is waiting
+  if (helping) p->numHelpersWaiting++;
+  {
+    std::unique_lock<std::mutex> lock(p->doneMutex);
+    p->doneCond.wait(lock,[&]() { return ready() || (helping && p->numSubmitted!=submitted); });
+  }
+  if (helping) p->numHelpersWaiting--;
+}
+
+ThreadPool *&ThreadPool::current()
+{
+  static thread_local ThreadPool *pool = nullptr;
+  return pool;
+}
+
+std::size_t ThreadPool::nextId()
+{
+  static std::atomic<std::size_t> id = 0;
+  return id++;
+}
@@ -16,19 +16,133 @@
 #ifndef THREADPOOL_H
 #define THREADPOOL_H
 
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
-/// Class managing a pool of worker threads.
+#include "chrometrace.h"
+
+/// Priority of a task queued to the TaskScheduler.
+/// Workers prefer tasks of a higher priority, but the order is not strictly enforced.
+enum class TaskPriority { Low=0, Normal=1, High=2 };
+
+/// Process wide set of worker threads that execute tasks.
+///
+/// Each worker has its own queue of tasks. A worker first runs the tasks from its own queue,
+/// most recently added first, and when that queue is empty it steals the oldest task from
+/// the queue of another worker. Tasks queued from a worker thread are added to the queue of
+/// that worker, so subtasks are usually run by the thread that created them.
+///
+/// Use the ThreadPool class to queue work, this class only provides the shared workers.
+class TaskScheduler
+{
+  public:
+    using Task = std::function<void()>;
+
+    /// Identifies the group (the ThreadPool) a task was queued for.
+    using TaskGroup = const void *;
+
+    /// Selects the groups whose tasks a waiting worker may run.
+    using HelpFilter = std::function<bool(TaskGroup)>;
+
+    /// Function that captures thread local state of the calling thread and returns a function
+    /// that restores it.
+    using SaveStateFunc = std::function<std::function<void()>()>;
+
+    static TaskScheduler &instance();
+
+    /// Makes sure at least \a numWorkers worker threads are available.
+    void reserve(std::size_t numWorkers);
+
+    /// Queues \a task of \a group to be run by one of the workers.
+    void submit(Task &&task,TaskPriority priority,TaskGroup group);
+
+    /// Runs one of the queued tasks whose group is accepted by \a filter on the calling thread,
+    /// saving and restoring the thread local state registered with registerThreadState() around it.
+    /// Returns false if there was no such task to run.
+    bool runPendingTask(const HelpFilter &filter);
+
+    /// Registers thread local state that must not be changed for a task that waits while
+    /// its thread runs other tasks, see ThreadStateRegistration.
+    /// Must be called before any task is queued.
+    void registerThreadState(SaveStateFunc save);
+
+    /// Returns true if the calling thread is one of the worker threads.
+    static bool isWorkerThread();
+
+    /// Waits until \a ready returns true. When called from a worker thread, queued tasks whose
+    /// group is accepted by \a filter are run while waiting, so the worker is not lost for the
+    /// work being waited for. \a ready is checked again each time a task finishes.
+    /// Use ThreadPool::wait() to wait from within a task of a pool, so the pool can start
+    /// another task meanwhile.
+    template<class Pred>
+    void waitUntil(Pred ready,const HelpFilter &filter)
+    {
+      bool helping = isWorkerThread() && filter;
+      while (!ready())
+      {
+        std::size_t submitted = numSubmitted();
+        if (!helping || !runPendingTask(filter))
+        {
+          idleWait([&ready]() { return ready(); },helping,submitted);
+        }
+      }
+    }
+
+    /// Waits for the future \a f to become ready and returns its value, see waitUntil().
+    template<class T>
+    T waitFor(std::future<T> &f,const HelpFilter &filter)
+    {
+      waitUntil([&f]() { return f.wait_for(std::chrono::seconds(0))==std::future_status::ready; },filter);
+      return f.get();
+    }
+
+  private:
+    TaskScheduler();
+   ~TaskScheduler();
+    TaskScheduler(const TaskScheduler &) = delete;
+    TaskScheduler &operator=(const TaskScheduler &) = delete;
+    std::size_t numSubmitted() const;
+    // waits until ready() returns true or, if helping, a task is submitted after \a submitted tasks
+    void idleWait(const std::function<bool()> &ready,bool helping,std::size_t submitted);
+    struct Private;
+    std::unique_ptr<Private> p;
+};
+
+/// Registers thread local state with the TaskScheduler when constructed, meant to be used
+/// for a static object next to the thread local variables.
+///
+/// Usage example:
+/// @code
+/// static thread_local int t_level = 0;
+/// static ThreadStateRegistration t_levelState([]() {
+///   int level = t_level;
+///   return std::function<void()>([level]() { t_level = level; });
+/// });
+/// @endcode
+struct ThreadStateRegistration
+{
+  explicit ThreadStateRegistration(TaskScheduler::SaveStateFunc save)
+  {
+    TaskScheduler::instance().registerThreadState(std::move(save));
+  }
+};
+
+/// Class for queueing work to the process wide TaskScheduler.
 /// Work can be queued by passing a function to queue(). A future will be
 /// returned that can be used to obtain the result of the function after execution.
+/// At most N of the tasks queued via the same pool run at the same time, not counting
+/// tasks that are waiting in wait() or finish(), whose place is given to a pending task.
+/// Tasks of a pool with a higher priority are preferred by the workers.
+/// Destroying the pool waits until all of its tasks have finished.
 ///
 /// Usage example:
 /// @code
@@ -41,27 +155,26 @@
 /// }
 /// for (auto &f : results)
 /// {
-///   printf("Result %d:\n", f.get());
+///   printf("Result %d:\n", pool.wait(f));
 /// }
 /// @endcode
 class ThreadPool
 {
   public:
-    /// start N threads in the thread pool.
-    ThreadPool(std::size_t N=1)
+    /// creates a pool that runs at most N tasks in parallel.
+    /// The \a name identifies the pool's tasks when profiling with `-d trace=<file>`.
+    ThreadPool(std::size_t N=1,const char *name="worker",TaskPriority priority=TaskPriority::Normal)
+      : m_name(name), m_priority(priority), m_maxRunning(N>0 ? N : 1), m_id(nextId())
     {
-      for (std::size_t i = 0; i < N; ++i)
+      // remember the pools whose task created this pool, see helpFilter()
+      if (ThreadPool *parent = current())
       {
-        // each thread is a std::async running thread_task():
-        m_finished.push_back(
-            std::async(
-              std::launch::async,
-              [this]{ threadTask(); }
-              )
-            );
+        m_ancestors = parent->m_ancestors;
+        m_ancestors.push_back(parent->m_id);
       }
+      TaskScheduler::instance().reserve(m_maxRunning);
     }
-    /// deletes the thread pool by finishing all threads
+    /// waits for all tasks queued via this pool to finish
     ~ThreadPool()
     {
       finish();
@@ -86,67 +199,150 @@ class ThreadPool
       auto taskFunc = [ptr]() { if (ptr->valid()) (*ptr)(); };
 
       auto r=ptr->get_future(); // get the return value before we hand off the task
+      bool runNow = false;
       {
         std::unique_lock<std::mutex> l(m_mutex);
-        m_work.emplace_back(taskFunc);
-        m_cond.notify_one(); // wake a thread to work on the task
+        m_outstanding++;
+        if (m_running<m_maxRunning)
+        {
+          m_running++;
+          runNow = true;
+        }
+        else // wait until one of the running tasks of this pool finishes
+        {
+          m_pending.emplace_back(std::move(taskFunc));
+        }
+      }
+      if (runNow)
+      {
+        submit(std::move(taskFunc));
       }
 
       return r; // return the future result of the task
     }
 
-    /// finish enques a "stop the thread" message for every thread,
-    /// then waits for them to finish
+    /// Waits for the result of a task queued via this pool.
+    /// Unlike calling get() on the future directly, this is safe to use from within a task.
+    /// When called from within a task, the thread runs pending tasks of this pool, and of
+    /// pools created by its tasks, while waiting. The caller must therefore not hold a lock
+    /// that these tasks may take.
+    template<class T>
+    T wait(std::future<T> &f)
+    {
+      WaitingTask waiting;
+      return TaskScheduler::instance().waitFor(f,helpFilter());
+    }
+
+    /// Waits until all tasks queued via this pool have finished.
+    /// The same constraint as for wait() applies.
     void finish()
     {
+      WaitingTask waiting;
+      TaskScheduler::instance().waitUntil([this]()
       {
         std::unique_lock<std::mutex> l(m_mutex);
-        for(auto&& u : m_finished)
+        return m_outstanding==0;
+      },helpFilter());
+    }
+
+  private:
+    // the pool whose task runs on the calling thread, if any
+    static ThreadPool *&current();
+
+    static std::size_t nextId();
+
+    // A thread waiting for this pool only runs tasks that the wait depends on: those of this pool
+    // and of pools created by its tasks. Tasks of unrelated pools could need a lock held by the
+    // waiting task, or wait themselves, nesting ever deeper on the same stack.
+    // A pool with queued tasks is still alive, so the group can be dereferenced.
+    TaskScheduler::HelpFilter helpFilter() const
+    {
+      std::size_t id = m_id;
+      return [id](TaskScheduler::TaskGroup group)
+      {
+        const ThreadPool *pool = static_cast<const ThreadPool*>(group);
+        return pool && (pool->m_id==id ||
+                        std::find(pool->m_ancestors.begin(),pool->m_ancestors.end(),id)!=pool->m_ancestors.end());
+      };
+    }
+
+    // While a task waits, a pending task of its pool may run in its place. Otherwise all running
+    // tasks of a pool could be waiting for subtasks that are pending in the same pool.
+    struct WaitingTask
+    {
+      WaitingTask() : pool(current()) { if (pool) pool->lendSlot(); }
+     ~WaitingTask() { if (pool) pool->reclaimSlot(); }
+      WaitingTask(const WaitingTask &) = delete;
+      WaitingTask &operator=(const WaitingTask &) = delete;
+      ThreadPool *pool;
+    };
+
+    void lendSlot()
+    {
+      std::function<void()> next;
+      {
+        std::unique_lock<std::mutex> l(m_mutex);
+        if (!m_pending.empty())
+        {
+          next = std::move(m_pending.front());
+          m_pending.pop_front();
+        }
+        else
         {
-          (void)u; //unused_variable, to silence the compiler warning about unused variables
-          m_work.emplace_back(); // insert empty function object to signal abort
+          m_running--;
         }
       }
-      m_cond.notify_all();
-      m_finished.clear();
+      if (next) submit(std::move(next));
+    }
+
+    void reclaimSlot()
+    {
+      std::unique_lock<std::mutex> l(m_mutex);
+      m_running++;
     }
-  private:
 
-    // the work that a worker thread does:
-    void threadTask()
+    // hands a task to the scheduler, the task submits the next pending task of the pool when done
+    void submit(std::function<void()> &&f)
     {
-      while(true)
+      TaskScheduler::instance().submit([this,f=std::move(f)]()
       {
-        // pop a task off the queue:
-        std::function<void()> f;
         {
-          // usual thread-safe queue code:
+          ChromeTrace::Span span(m_name,"task");
+          ThreadPool *prev = current();
+          current() = this;
+          f();
+          current() = prev;
+        }
+        std::function<void()> next;
+        {
           std::unique_lock<std::mutex> l(m_mutex);
-          if (m_work.empty())
+          if (!m_pending.empty())
           {
-            m_cond.wait(l,[&]{return !m_work.empty();});
+            next = std::move(m_pending.front());
+            m_pending.pop_front();
           }
-          f = std::move(m_work.front());
-          m_work.pop_front();
+          else
+          {
+            m_running--;
+          }
+          // after this, the pool may be destroyed unless there is a next task
+          m_outstanding--;
         }
-        // if the function is empty, it means we are asked to abort
-        if (!f) return;
-        // run the task
-        f();
-      }
+        if (next) submit(std::move(next));
+      },m_priority,this);
     }
 
-    // the mutex, condition variable and deque form a single
-    // thread-safe triggered queue of tasks:
-    std::mutex m_mutex;
-    std::condition_variable m_cond;
-
-    // hold the queue of work
-    std::deque< std::function<void()> > m_work;
+    // name of the pool, used for profiling
+    const char *m_name;
+    TaskPriority m_priority;
+    std::size_t m_maxRunning;
+    std::size_t m_id;                      // unique id, also for pools created at the same address later
+    std::vector<std::size_t> m_ancestors;  // ids of the pools whose task (indirectly) created this pool
 
-    // this holds futures representing the worker threads being done:
-    std::vector< std::future<void> > m_finished;
+    std::mutex m_mutex;
+    std::size_t m_running = 0;      // number of tasks handed to the scheduler
+    std::size_t m_outstanding = 0;  // number of tasks queued but not yet finished
+    std::deque< std::function<void()> > m_pending; // tasks waiting for one of the running tasks to finish
 };
 
 #endif
-
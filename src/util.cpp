@@ -77,6 +77,8 @@
 #include "moduledef.h"
 #include "trace.h"
 #include "stringutil.h"
+#include "namefilter.h"
+#include "symbolmap.h"
 
 #define ENABLE_TRACINGSUPPORT 0
 
@@ -901,6 +903,49 @@ bool leftScopeMatch(const QCString &scope, const QCString &name)
 }
 
 
+// The names of all symbols (without their scope) when initLinkifyFilter() was called.
+// A word can only link to a symbol if one of its scope parts is such a name.
+static NameFilter g_linkifyFilter;
+static size_t     g_linkifyFilterSymbols = 0;
+
+void initLinkifyFilter()
+{
+  g_linkifyFilter = NameFilter();
+  if (Config_getBool(OPTIMIZE_OUTPUT_VHDL)) return; // VHDL symbols are stored under their full name
+  std::vector<std::string_view> names;
+  names.reserve(Doxygen::symbolMap->size());
+  for (const auto &[name,defs] : *Doxygen::symbolMap)
+  {
+    std::string_view n = name.str();
+    names.push_back(n);
+    if (n.size()>2 && n.substr(n.size()-2)==std::string_view("-p")) // Objective-C protocols are also found without the suffix
+    {
+      names.push_back(n.substr(0,n.size()-2));
+    }
+  }
+  g_linkifyFilter = NameFilter(names);
+  g_linkifyFilterSymbols = Doxygen::symbolMap->size();
+}
+
+// returns FALSE if resolving matchWord cannot find a symbol, so the lookups can be skipped
+static bool mayLinkToSymbol(const QCString &matchWord)
+{
+  if (g_linkifyFilter.isEmpty() || Doxygen::symbolMap->size()!=g_linkifyFilterSymbols)
+  {
+    return true; // no filter, or symbols were added after creating it
+  }
+  std::string_view s = matchWord.view();
+  size_t p=0;
+  while (p<=s.size())
+  {
+    size_t e = s.find("::",p);
+    if (e==std::string_view::npos) e=s.size();
+    if (e>p && g_linkifyFilter.contains(s.substr(p,e-p))) return true;
+    p=e+2;
+  }
+  return false;
+}
+
 void linkifyText(const TextGeneratorIntf &out, const Definition *scope,
     const FileDef *fileScope,const Definition *self,
     const QCString &text, bool autoBreak,bool external,
@@ -982,7 +1027,7 @@ void linkifyText(const TextGeneratorIntf &out, const Definition *scope,
     //printf("linkifyText word=%s matchWord=%s scope=%s\n",
     //    qPrint(word),qPrint(matchWord),scope ? qPrint(scope->name()) : "<none>");
     bool found=FALSE;
-    if (!insideString)
+    if (!insideString && mayLinkToSymbol(matchWord))
     {
       const ClassDef     *cd=nullptr;
       const ConceptDef   *cnd=nullptr;
@@ -3250,51 +3295,26 @@ void generateFileRef(OutputList &ol,const QCString &name,const QCString &text)
 /** Cache element for the file name to FileDef mapping cache. */
 struct FindFileCacheElem
 {
+  FindFileCacheElem() = default;
   FindFileCacheElem(FileDef *fd,bool ambig) : fileDef(fd), isAmbig(ambig) {}
-  FileDef *fileDef;
-  bool isAmbig;
+  FileDef *fileDef = nullptr;
+  bool isAmbig = false;
 };
 
-static Cache<std::string,FindFileCacheElem> g_findFileDefCache(5000);
-
-static std::mutex g_findFileDefMutex;
+static ConcurrentCache<FindFileCacheElem> g_findFileDefCache(5000,8);
 
-FileDef *findFileDef(const FileNameLinkedMap *fnMap,const QCString &n,bool &ambig)
+static FindFileCacheElem findFileDefUncached(const FileNameLinkedMap *fnMap,const QCString &n)
 {
-  ambig=FALSE;
-  if (n.isEmpty()) return nullptr;
-
-
-  const int maxAddrSize = 20;
-  char addr[maxAddrSize];
-  qsnprintf(addr,maxAddrSize,"%p:",reinterpret_cast<const void*>(fnMap));
-  QCString key = addr;
-  key+=n;
-
-  std::lock_guard<std::mutex> lock(g_findFileDefMutex);
-  FindFileCacheElem *cachedResult = g_findFileDefCache.find(key.str());
-  //printf("key=%s cachedResult=%p\n",qPrint(key),cachedResult);
-  if (cachedResult)
-  {
-    ambig = cachedResult->isAmbig;
-    //printf("cached: fileDef=%p\n",cachedResult->fileDef);
-    return cachedResult->fileDef;
-  }
-  else
-  {
-    cachedResult = g_findFileDefCache.insert(key.str(),FindFileCacheElem(nullptr,FALSE));
-  }
-
   QCString name=Dir::cleanDirPath(n.str());
   QCString path;
-  if (name.isEmpty()) return nullptr;
+  if (name.isEmpty()) return FindFileCacheElem();
   int slashPos=std::max(name.findRev('/'),name.findRev('\\'));
   if (slashPos!=-1)
   {
     path=removeLongPathMarker(name.left(slashPos+1));
     name=name.right(name.length()-slashPos-1);
   }
-  if (name.isEmpty()) return nullptr;
+  if (name.isEmpty()) return FindFileCacheElem();
   const FileName *fn = fnMap->find(name);
   if (fn)
   {
@@ -3307,8 +3327,7 @@ FileDef *findFileDef(const FileNameLinkedMap *fnMap,const QCString &n,bool &ambi
                  fd->getPath().right(path.length()).lower()==path.lower();
       if (path.isEmpty() || isSamePath)
       {
-        cachedResult->fileDef = fd.get();
-        return fd.get();
+        return FindFileCacheElem(fd.get(),FALSE);
       }
     }
     else // file name alone is ambiguous
@@ -3326,18 +3345,41 @@ FileDef *findFileDef(const FileNameLinkedMap *fnMap,const QCString &n,bool &ambi
           lastMatch=fd;
         }
       }
-
-      ambig=(count>1);
-      cachedResult->isAmbig = ambig;
-      cachedResult->fileDef = lastMatch;
-      return lastMatch;
+      return FindFileCacheElem(lastMatch,count>1);
     }
   }
   else
   {
     //printf("not found!\n");
   }
-  return nullptr;
+  return FindFileCacheElem();
+}
+
+FileDef *findFileDef(const FileNameLinkedMap *fnMap,const QCString &n,bool &ambig)
+{
+  ambig=FALSE;
+  if (n.isEmpty()) return nullptr;
+
+
+  const int maxAddrSize = 20;
+  char addr[maxAddrSize];
+  qsnprintf(addr,maxAddrSize,"%p:",reinterpret_cast<const void*>(fnMap));
+  QCString key = addr;
+  key+=n;
+
+  std::optional<FindFileCacheElem> cachedResult = g_findFileDefCache.find(key.view());
+  //printf("key=%s cachedResult=%p\n",qPrint(key),cachedResult);
+  if (cachedResult)
+  {
+    ambig = cachedResult->isAmbig;
+    //printf("cached: fileDef=%p\n",cachedResult->fileDef);
+    return cachedResult->fileDef;
+  }
+
+  FindFileCacheElem result = findFileDefUncached(fnMap,n);
+  g_findFileDefCache.insert(key.view(),result);
+  ambig = result.isAmbig;
+  return result.fileDef;
 }
 
 //----------------------------------------------------------------------
@@ -5709,9 +5751,7 @@ QCString parseCommentAsText(const Definition *scope,const MemberDef *md,
   if (doc.isEmpty()) return "";
   //printf("parseCommentAsText(%s)\n",qPrint(doc));
   TextStream t;
-  auto parser { createDocParser() };
-  auto ast    { validatingParseDoc(*parser.get(),
-                                   fileName,lineNr,
+  auto ast    { DocAstCache::instance().parse(fileName,lineNr,
                                    scope,md,doc,FALSE,FALSE,
                                    QCString(),FALSE,FALSE,Config_getBool(MARKDOWN_SUPPORT)) };
   auto astImpl = dynamic_cast<const DocNodeAST*>(ast.get());
@@ -104,6 +104,11 @@ void linkifyText(const TextGeneratorIntf &ol,
                  int indentLevel=0
                 );
 
+/** Lets linkifyText() skip words that cannot be the name of a symbol without
+ *  resolving them. Call this when all symbols are known.
+ */
+void initLinkifyFilter();
+
 QCString fileToString(const QCString &name,bool filter=FALSE,bool isSourceCode=FALSE);
 
 struct GetDefInput
@@ -1997,7 +1997,7 @@ static void initUCF(Entry* root,const QCString &type,QCString &qcs,
 
   qcs.stripPrefix("=");
 
-  std::shared_ptr<Entry> current = std::make_shared<Entry>();
+  std::shared_ptr<Entry> current = makeEntry();
   current->vhdlSpec=VhdlSpecifier::UCF_CONST;
   current->section=EntryType::makeVariable();
   current->bodyLine=line;
@@ -2426,7 +2426,7 @@ void VhdlDocGen::createFlowChart(const MemberDef *mdef)
 
   auto parser { Doxygen::parserManager->getOutlineParser(".vhd") };
   VhdlDocGen::setFlowMember(mdef);
-  std::shared_ptr<Entry> root = std::make_shared<Entry>();
+  std::shared_ptr<Entry> root = makeEntry();
   StringVector filesInSameTu;
   parser->parseInput("",codeFragment.data(),root,nullptr);
 }
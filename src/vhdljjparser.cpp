@@ -164,7 +164,7 @@ void VHDLOutlineParser::parseInput(const QCString &fileName,const char *fileBuf,
   s->lastCompound=nullptr;
   s->lastEntity=nullptr;
   p->oldEntry = nullptr;
-  s->current=std::make_shared<Entry>();
+  s->current=makeEntry();
   initEntry(s->current.get());
   p->commentScanner.enterFile(fileName,p->yyLineNr);
   p->lineParse.reserve(200);
@@ -506,11 +506,11 @@ void VHDLOutlineParser::addCompInst(const QCString &n, const QCString &instName,
     {
       initEntry(s->current.get());
       // TODO: protect with mutex
-      g_instFiles.emplace_back(std::make_shared<Entry>(*s->current));
+      g_instFiles.emplace_back(makeEntry(*s->current));
       // TODO: end protect with mutex
     }
 
-    s->current=std::make_shared<Entry>();
+    s->current=makeEntry();
   }
   else
   {
@@ -549,7 +549,7 @@ void VHDLOutlineParser::addVhdlType(const QCString &n,int startLine,EntryType se
 
     if (!s->lastCompound && section.isVariable() &&  (spec == VhdlSpecifier::USE || spec == VhdlSpecifier::LIBRARY) )
     {
-      p->libUse.emplace_back(std::make_shared<Entry>(*s->current));
+      p->libUse.emplace_back(makeEntry(*s->current));
       s->current->reset();
     }
     newEntry();
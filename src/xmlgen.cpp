@@ -14,6 +14,7 @@
  */
 
 #include <stdlib.h>
+#include <functional>
 
 #include "textstream.h"
 #include "xmlgen.h"
@@ -51,6 +52,7 @@
 #include "portable.h"
 #include "outputlist.h"
 #include "moduledef.h"
+#include "threadpool.h"
 
 // no debug info
 #define XML_DB(x) do {} while(0)
@@ -398,25 +400,28 @@ static void writeXMLDocBlock(TextStream &t,
 
 void writeXMLCodeBlock(TextStream &t,FileDef *fd)
 {
-  auto intf=Doxygen::parserManager->getCodeParser(fd->getDefFileExtension());
-  SrcLangExt langExt = getLanguageFromFileName(fd->getDefFileExtension());
-  intf->resetCodeParserState();
   OutputCodeList xmlList;
   xmlList.add<XMLCodeGenerator>(&t);
   xmlList.startCodeFragment("DoxyCode");
-  intf->parseCode(xmlList,    // codeOutList
-                QCString(),   // scopeName
-                fileToString(fd->absFilePath(),Config_getBool(FILTER_SOURCE_FILES)),
-                langExt,     // lang
-                FALSE,       // isExampleBlock
-                QCString(),  // exampleName
-                fd,          // fileDef
-                -1,          // startLine
-                -1,          // endLine
-                FALSE,       // inlineFragment
-                nullptr,           // memberDef
-                TRUE         // showLineNumbers
-                );
+  if (!fd->replaySourceBody(xmlList)) // not already parsed while writing the source pages
+  {
+    auto intf=Doxygen::parserManager->getCodeParser(fd->getDefFileExtension());
+    SrcLangExt langExt = getLanguageFromFileName(fd->getDefFileExtension());
+    intf->resetCodeParserState();
+    intf->parseCode(xmlList,    // codeOutList
+                  QCString(),   // scopeName
+                  fileToString(fd->absFilePath(),Config_getBool(FILTER_SOURCE_FILES)),
+                  langExt,     // lang
+                  FALSE,       // isExampleBlock
+                  QCString(),  // exampleName
+                  fd,          // fileDef
+                  -1,          // startLine
+                  -1,          // endLine
+                  FALSE,       // inlineFragment
+                  nullptr,           // memberDef
+                  TRUE         // showLineNumbers
+                  );
+  }
   xmlList.endCodeFragment("DoxyCode");
   xmlList.get<XMLCodeGenerator>(OutputType::XML)->finish();
 }
@@ -2115,6 +2120,141 @@ static void generateXMLForPage(PageDef *pd,TextStream &ti,bool isExample)
   ti << "  </compound>\n";
 }
 
+//! Writes the XML file for each compound and adds its entry for index.xml to \a ti.
+//! With multiple threads, the compounds are written in parallel and the entries
+//! are collected per compound, so index.xml is the same as for a single thread.
+static void generateXMLForCompounds(TextStream &ti)
+{
+  // each function writes one compound and its index entry to the stream passed
+  using CompoundWriter = std::function<void(TextStream &)>;
+  std::vector<CompoundWriter> writers;
+  for (const auto &cd : *Doxygen::classLinkedMap)
+  {
+    const ClassDef *cdp = cd.get();
+    writers.emplace_back([cdp](TextStream &t) { generateXMLForClass(cdp,t); });
+  }
+  for (const auto &cd : *Doxygen::conceptLinkedMap)
+  {
+    const ConceptDef *cdp = cd.get();
+    writers.emplace_back([cdp](TextStream &t)
+    {
+      msg("Generating XML output for concept %s\n",qPrint(cdp->displayName()));
+      generateXMLForConcept(cdp,t);
+    });
+  }
+  for (const auto &nd : *Doxygen::namespaceLinkedMap)
+  {
+    const NamespaceDef *ndp = nd.get();
+    writers.emplace_back([ndp](TextStream &t)
+    {
+      msg("Generating XML output for namespace %s\n",qPrint(ndp->displayName()));
+      generateXMLForNamespace(ndp,t);
+    });
+  }
+  for (const auto &fn : *Doxygen::inputNameLinkedMap)
+  {
+    for (const auto &fd : *fn)
+    {
+      FileDef *fdp = fd.get();
+      writers.emplace_back([fdp](TextStream &t)
+      {
+        msg("Generating XML output for file %s\n",qPrint(fdp->name()));
+        generateXMLForFile(fdp,t);
+      });
+    }
+  }
+  for (const auto &gd : *Doxygen::groupLinkedMap)
+  {
+    const GroupDef *gdp = gd.get();
+    writers.emplace_back([gdp](TextStream &t)
+    {
+      msg("Generating XML output for group %s\n",qPrint(gdp->name()));
+      generateXMLForGroup(gdp,t);
+    });
+  }
+  for (const auto &pd : *Doxygen::pageLinkedMap)
+  {
+    PageDef *pdp = pd.get();
+    writers.emplace_back([pdp](TextStream &t)
+    {
+      msg("Generating XML output for page %s\n",qPrint(pdp->name()));
+      generateXMLForPage(pdp,t,FALSE);
+    });
+  }
+  for (const auto &dd : *Doxygen::dirLinkedMap)
+  {
+    DirDef *ddp = dd.get();
+    writers.emplace_back([ddp](TextStream &t)
+    {
+      msg("Generate XML output for dir %s\n",qPrint(ddp->name()));
+      generateXMLForDir(ddp,t);
+    });
+  }
+  for (const auto &mod : ModuleManager::instance().modules())
+  {
+    const ModuleDef *modp = mod.get();
+    writers.emplace_back([modp](TextStream &t)
+    {
+      msg("Generating XML output for module %s\n",qPrint(modp->name()));
+      generateXMLForModule(modp,t);
+    });
+  }
+  for (const auto &pd : *Doxygen::exampleLinkedMap)
+  {
+    PageDef *pdp = pd.get();
+    writers.emplace_back([pdp](TextStream &t)
+    {
+      msg("Generating XML output for example %s\n",qPrint(pdp->name()));
+      generateXMLForPage(pdp,t,TRUE);
+    });
+  }
+  if (Doxygen::mainPage)
+  {
+    writers.emplace_back([](TextStream &t)
+    {
+      msg("Generating XML output for the main page\n");
+      generateXMLForPage(Doxygen::mainPage.get(),t,FALSE);
+    });
+  }
+
+  // generatingXmlOutput is thread local, so it is set by each task rather than for the whole phase
+  auto runWriter = [](const CompoundWriter &writer,TextStream &t)
+  {
+    bool wasGeneratingXml = Doxygen::generatingXmlOutput;
+    Doxygen::generatingXmlOutput = TRUE;
+    writer(t);
+    Doxygen::generatingXmlOutput = wasGeneratingXml;
+  };
+
+  std::size_t numThreads = static_cast<std::size_t>(Config_getInt(NUM_PROC_THREADS));
+  if (numThreads>1) // multi threaded processing
+  {
+    ThreadPool threadPool(numThreads,"xml");
+    std::vector< std::future<std::string> > results;
+    for (const auto &writer : writers)
+    {
+      results.emplace_back(threadPool.queue([&writer,&runWriter]()
+      {
+        TextStream t;
+        runWriter(writer,t);
+        return t.str();
+      }));
+    }
+    // add the index entries in the original order
+    for (auto &f : results)
+    {
+      ti << threadPool.wait(f);
+    }
+  }
+  else // single threaded processing
+  {
+    for (const auto &writer : writers)
+    {
+      runWriter(writer,ti);
+    }
+  }
+}
+
 void generateXML()
 {
   // + classes
@@ -2237,58 +2377,7 @@ void generateXML()
     t << "xml:lang=\"" << theTranslator->trISOLang() << "\"";
     t << ">\n";
 
-    for (const auto &cd : *Doxygen::classLinkedMap)
-    {
-      generateXMLForClass(cd.get(),t);
-    }
-    for (const auto &cd : *Doxygen::conceptLinkedMap)
-    {
-      msg("Generating XML output for concept %s\n",qPrint(cd->displayName()));
-      generateXMLForConcept(cd.get(),t);
-    }
-    for (const auto &nd : *Doxygen::namespaceLinkedMap)
-    {
-      msg("Generating XML output for namespace %s\n",qPrint(nd->displayName()));
-      generateXMLForNamespace(nd.get(),t);
-    }
-    for (const auto &fn : *Doxygen::inputNameLinkedMap)
-    {
-      for (const auto &fd : *fn)
-      {
-        msg("Generating XML output for file %s\n",qPrint(fd->name()));
-        generateXMLForFile(fd.get(),t);
-      }
-    }
-    for (const auto &gd : *Doxygen::groupLinkedMap)
-    {
-      msg("Generating XML output for group %s\n",qPrint(gd->name()));
-      generateXMLForGroup(gd.get(),t);
-    }
-    for (const auto &pd : *Doxygen::pageLinkedMap)
-    {
-      msg("Generating XML output for page %s\n",qPrint(pd->name()));
-      generateXMLForPage(pd.get(),t,FALSE);
-    }
-    for (const auto &dd : *Doxygen::dirLinkedMap)
-    {
-      msg("Generate XML output for dir %s\n",qPrint(dd->name()));
-      generateXMLForDir(dd.get(),t);
-    }
-    for (const auto &mod : ModuleManager::instance().modules())
-    {
-      msg("Generating XML output for module %s\n",qPrint(mod->name()));
-      generateXMLForModule(mod.get(),t);
-    }
-    for (const auto &pd : *Doxygen::exampleLinkedMap)
-    {
-      msg("Generating XML output for example %s\n",qPrint(pd->name()));
-      generateXMLForPage(pd.get(),t,TRUE);
-    }
-    if (Doxygen::mainPage)
-    {
-      msg("Generating XML output for the main page\n");
-      generateXMLForPage(Doxygen::mainPage.get(),t,FALSE);
-    }
+    generateXMLForCompounds(t);
 
     //t << "  </compoundlist>\n";
     t << "</doxygenindex>\n";
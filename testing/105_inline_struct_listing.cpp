@@ -0,0 +1,10 @@
+// objective: test that the XML source listing links to inlined simple structs
+// check: 105__inline__struct__listing_8cpp.xml
+// config: INLINE_SIMPLE_STRUCTS=YES
+// config: SOURCE_BROWSER=YES
+// config: GENERATE_HTML=YES
+// config: XML_PROGRAMLISTING=YES
+// config: XML_PROGRAMLISTING_MEMORY=16
+// config: EXTRACT_ALL=YES
+
+struct Point {};
@@ -0,0 +1,7 @@
+// objective: test that a C++ module is still found when the parse cache is used
+// check: module_hello.xml
+// config: PARSE_CACHE_DIR=$OUTPUTDIR/cache
+// runs: 2
+
+export module Hello;
+import World;
@@ -0,0 +1,10 @@
+// objective: test that a source listing kept for the XML output matches a fresh parse
+// check: 107__listing__replay_8cpp.xml
+// config: SOURCE_BROWSER=YES
+// config: GENERATE_HTML=YES
+// config: XML_PROGRAMLISTING=YES
+// config: XML_PROGRAMLISTING_MEMORY=16
+// config: EXTRACT_ALL=YES
+
+struct Base {};
+struct Derived : Base {};
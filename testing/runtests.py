@@ -148,7 +148,7 @@ class Tester:
             print('WARN_LOGFILE=%s/warnings.log' % self.test_out, file=f)
             if 'config' in self.config:
                 for option in self.config['config']:
-                    print(option, file=f)
+                    print(option.replace('$OUTPUTDIR',self.test_out), file=f)
             if (self.args.xml or self.args.xmlxsd):
                 print('GENERATE_XML=YES', file=f)
                 print('XML_OUTPUT=%s/out' % self.test_out, file=f)
@@ -200,9 +200,12 @@ class Tester:
         if (self.args.noredir):
             redir=''
 
-        if os.system('%s %s %s/Doxyfile %s' % (self.args.doxygen,self.args.doxygen_dbg,self.test_out,redir))!=0:
-            print('Error: failed to run %s on %s/Doxyfile' % (self.args.doxygen,self.test_out))
-            sys.exit(1)
+        # a test can run doxygen more than once, e.g. to check a run that uses the results of the previous one
+        runs = int(self.config['runs'][0]) if 'runs' in self.config else 1
+        for _ in range(runs):
+            if os.system('%s %s %s/Doxyfile %s' % (self.args.doxygen,self.args.doxygen_dbg,self.test_out,redir))!=0:
+                print('Error: failed to run %s on %s/Doxyfile' % (self.args.doxygen,self.test_out))
+                sys.exit(1)
 
 
     def check_link_rtf_file(self,fil):
@@ -264,6 +267,7 @@ class Tester:
                 with xopen(out_file,'w') as f:
                     print(data,file=f)
         shutil.rmtree(self.test_out+'/out',ignore_errors=True)
+        shutil.rmtree(self.test_out+'/cache',ignore_errors=True) # used by tests that run doxygen more than once
         os.remove(self.test_out+'/Doxyfile')
         os.remove(self.test_out+'/warnings.log')
         return True